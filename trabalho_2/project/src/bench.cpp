@@ -0,0 +1,308 @@
+#include "bench.hpp"
+#include "constants.hpp"
+#include "logger.hpp"
+#include "store.hpp"
+#include "utils.hpp"
+#include "workload.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void read_scaling_benchmark(UnifiedRepositoryFacade &repo) {
+  int num_blocks = registry_get(GlobalRegistryIndex::NumBlocks);
+  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  int world_rank = registry_get(GlobalRegistryIndex::WorldRank);
+
+  std::vector<int> keys(num_blocks);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shared_ptr<uint8_t[]> warmup =
+      std::make_shared<uint8_t[]>(num_blocks * block_size);
+  repo.read(keys, std::span<uint8_t>(warmup.get(), num_blocks * block_size));
+
+  if (world_rank == MASTER_INSTANCE_ID)
+    std::cout << std::format("Read scaling benchmark ({0} blocks of {1} bytes, "
+                             "{2} ms per round)",
+                             num_blocks, block_size, BENCH_ROUND_MILLIS)
+              << std::endl;
+
+  for (int num_threads = 1; num_threads <= BENCH_MAX_THREADS;
+       num_threads *= 2) {
+    std::atomic<bool> stop = false;
+    std::vector<uint64_t> counts(num_threads);
+    std::vector<std::thread> threads;
+
+    MPI_Barrier(worker_comm());
+
+    for (int t = 0; t < num_threads; t++) {
+      threads.emplace_back([&, t] {
+        std::mt19937 rng(world_rank * BENCH_MAX_THREADS + t);
+        block buffer = std::make_shared<uint8_t[]>(block_size);
+        uint64_t count = 0;
+
+        while (!stop.load(std::memory_order_relaxed)) {
+          repo.read(rng() % num_blocks,
+                    std::span<uint8_t>(buffer.get(), block_size));
+          count++;
+        }
+
+        counts[t] = count;
+      });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(BENCH_ROUND_MILLIS));
+    stop = true;
+    for (std::thread &thread : threads)
+      thread.join();
+
+    uint64_t local_total = std::accumulate(counts.begin(), counts.end(), 0ULL);
+    uint64_t total = 0;
+    MPI_Reduce(&local_total, &total, 1, MPI_UINT64_T, MPI_SUM,
+               MASTER_INSTANCE_ID, worker_comm());
+
+    thread_safe_log_with_id(std::format(
+        "Benchmark round with {0} threads performed {1} reads", num_threads,
+        local_total));
+
+    if (world_rank == MASTER_INSTANCE_ID)
+      std::cout << std::format("{0} threads/worker: {1} reads/s", num_threads,
+                               total * 1000 / BENCH_ROUND_MILLIS)
+                << std::endl;
+  }
+
+  CacheStats stats = repo.cache_stats();
+  std::array<uint64_t, 6> local_counts = {
+      stats.hits,       stats.misses,            stats.evictions,
+      stats.prefetches, stats.useful_prefetches, stats.wasted_prefetches};
+  std::array<uint64_t, 6> counts = {0, 0, 0, 0, 0, 0};
+  MPI_Reduce(local_counts.data(), counts.data(), counts.size(), MPI_UINT64_T,
+             MPI_SUM, MASTER_INSTANCE_ID, worker_comm());
+
+  if (world_rank == MASTER_INSTANCE_ID)
+    std::cout << std::format("Remote block cache: {0} hits, {1} misses, {2} "
+                             "evictions; {3} prefetches, {4} useful, {5} "
+                             "wasted",
+                             counts[0], counts[1], counts[2], counts[3],
+                             counts[4], counts[5])
+              << std::endl;
+}
+
+/**
+ * Name under which value `value` of enumerated option `name` is passed in
+ */
+static std::string option_value_name(const std::string &name, int value) {
+  for (const auto &[choice, choice_value] : option_specs().at(name).choices)
+    if (choice_value == value)
+      return choice;
+
+  return std::to_string(value);
+}
+
+/**
+ * Options recorded in every row of `BENCH_CSV_PATH` on top of the workload
+ * itself, so that runs differing only in them can be told apart
+ */
+static const std::vector<std::string> recorded_options = {
+    "write-mode", "write-window", "coherence", "cache-size", "cache-policy",
+    "placement", "replicas", "prefetch-depth", "migration-threshold"};
+
+void workload_benchmark(UnifiedRepositoryFacade &repo) {
+  int num_blocks = registry_get(GlobalRegistryIndex::NumBlocks);
+  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  int world_rank = registry_get(GlobalRegistryIndex::WorldRank);
+  int num_workers =
+      get_num_worker_procs(registry_get(GlobalRegistryIndex::WorldSize));
+  int read_ratio = registry_get(GlobalRegistryIndex::ReadRatio);
+  int op_blocks = registry_get(GlobalRegistryIndex::OperationBlocks);
+  int distribution = registry_get(GlobalRegistryIndex::KeyDistribution);
+  int num_threads = registry_get(GlobalRegistryIndex::BenchThreads);
+  int duration = registry_get(GlobalRegistryIndex::DurationMillis);
+  int operations = registry_get(GlobalRegistryIndex::OperationCount);
+
+  if (op_blocks > num_blocks)
+    throw std::runtime_error(std::format(
+        "Operations over {0} blocks do not fit in {1} blocks", op_blocks,
+        num_blocks));
+
+  if (operations == 0 && duration == 0)
+    duration = DEFAULT_WORKLOAD_DURATION_MILLIS;
+
+  int positions = num_blocks - op_blocks + 1;
+  int op_size = op_blocks * block_size;
+  std::atomic<bool> stop = false;
+  std::vector<uint64_t> counts(num_threads);
+  std::vector<LatencyHistogram> histograms(num_threads);
+  std::vector<std::thread> threads;
+
+  MPI_Barrier(worker_comm());
+  auto start = std::chrono::steady_clock::now();
+
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      int stream = world_rank * num_threads + t;
+      std::mt19937 rng(stream);
+      // Sequential streams start evenly spread over the blocks
+      std::unique_ptr<KeyGenerator> generator = make_key_generator(
+          distribution, positions, rng(), op_blocks,
+          static_cast<long>(stream) * positions / (num_workers * num_threads));
+
+      std::shared_ptr<uint8_t[]> contents = std::make_shared<uint8_t[]>(op_size);
+      std::generate_n(contents.get(), op_size, [&] { return rng(); });
+      std::shared_ptr<uint8_t[]> buffer = std::make_shared<uint8_t[]>(op_size);
+      std::vector<int> keys(op_blocks);
+      std::vector<WriteMessageBuffer> entries;
+      uint64_t count = 0;
+
+      while (operations > 0 ? count < static_cast<uint64_t>(operations)
+                            : !stop.load(std::memory_order_relaxed)) {
+        int first = generator->next();
+        bool is_read = static_cast<int>(rng() % 100) < read_ratio;
+        auto begin = std::chrono::steady_clock::now();
+
+        if (is_read) {
+          std::iota(keys.begin(), keys.end(), first);
+          repo.read(keys, std::span<uint8_t>(buffer.get(), op_size));
+        } else {
+          entries.clear();
+          for (int i = 0; i < op_blocks; i++)
+            entries.push_back(WriteMessageBuffer(
+                first + i, block(contents, contents.get() + i * block_size),
+                0, block_size));
+          repo.write(entries);
+        }
+
+        histograms[t].record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin)
+                .count());
+        count++;
+      }
+
+      counts[t] = count;
+    });
+  }
+
+  if (operations == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+    stop = true;
+  }
+
+  for (std::thread &thread : threads)
+    thread.join();
+
+  // Writes still buffered or unacknowledged are part of the run
+  repo.fence();
+  uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+  LatencyHistogram histogram;
+  for (const LatencyHistogram &thread_histogram : histograms)
+    histogram.merge(thread_histogram);
+
+  // Per-worker rows: operations, elapsed nanoseconds and latency percentiles
+  std::array<uint64_t, 5> row = {histogram.count(), elapsed,
+                                 histogram.percentile(0.5),
+                                 histogram.percentile(0.99),
+                                 histogram.percentile(0.999)};
+  std::vector<uint64_t> rows(row.size() * num_workers);
+  MPI_Gather(row.data(), row.size(), MPI_UINT64_T, rows.data(), row.size(),
+             MPI_UINT64_T, MASTER_INSTANCE_ID, worker_comm());
+
+  LatencyHistogram total;
+  MPI_Reduce(histogram.buckets().data(), total.buckets().data(),
+             histogram.buckets().size(), MPI_UINT64_T, MPI_SUM,
+             MASTER_INSTANCE_ID, worker_comm());
+
+  thread_safe_log_with_id(std::format(
+      "Workload benchmark performed {0} operations in {1} ns", row[0],
+      elapsed));
+
+  if (world_rank != MASTER_INSTANCE_ID)
+    return;
+
+  std::string config = std::format(
+      "{0},{1},{2},{3},{4},{5},{6},{7},{8}",
+      registry_get(GlobalRegistryIndex::Timestamp),
+      option_value_name("backend",
+                        registry_get(GlobalRegistryIndex::Backend)),
+      num_workers, num_threads, block_size, num_blocks, read_ratio, op_blocks,
+      option_value_name("key-dist", distribution));
+  std::string header = "timestamp,backend,workers,threads,block_size,"
+                       "num_blocks,read_ratio,op_blocks,key_dist";
+  for (const std::string &name : recorded_options) {
+    config += "," + option_value_name(
+                        name, registry_get(option_specs().at(name).index));
+    std::string column = name;
+    std::replace(column.begin(), column.end(), '-', '_');
+    header += "," + column;
+  }
+  header += ",rank,operations,seconds,ops_per_sec,mb_per_sec,p50_us,p99_us,"
+            "p999_us";
+
+  auto format_row = [&](const std::string &rank, uint64_t ops,
+                        uint64_t nanos, uint64_t p50, uint64_t p99,
+                        uint64_t p999) {
+    double seconds = nanos / 1e9;
+    return std::format("{0},{1},{2},{3},{4},{5},{6},{7},{8}", config, rank,
+                       ops, seconds, ops / seconds,
+                       ops * op_size / 1e6 / seconds, p50 / 1e3, p99 / 1e3,
+                       p999 / 1e3);
+  };
+
+  std::vector<std::string> lines;
+  uint64_t total_ops = 0, max_elapsed = 0;
+  for (int rank = 0; rank < num_workers; rank++) {
+    const uint64_t *r = rows.data() + rank * row.size();
+    lines.push_back(
+        format_row(std::to_string(rank), r[0], r[1], r[2], r[3], r[4]));
+    total_ops += r[0];
+    max_elapsed = std::max(max_elapsed, r[1]);
+  }
+  // Throughput over every worker is taken over the run of the slowest one
+  lines.push_back(format_row("all", total_ops, max_elapsed,
+                             total.percentile(0.5), total.percentile(0.99),
+                             total.percentile(0.999)));
+
+  create_directory(BENCH_DIR);
+  std::string existing_header;
+  std::getline(std::ifstream(BENCH_CSV_PATH), existing_header);
+
+  // Rows of another layout are kept aside rather than mixed with these
+  if (!existing_header.empty() && existing_header != header) {
+    std::rename(BENCH_CSV_PATH, BENCH_CSV_PATH ".old");
+    std::cout << std::format("Moved {0} (of another layout) to {0}.old",
+                             BENCH_CSV_PATH)
+              << std::endl;
+  }
+
+  bool is_new = existing_header != header;
+  std::ofstream csv(BENCH_CSV_PATH, std::ios::app);
+  if (is_new)
+    csv << header << std::endl;
+
+  std::cout << std::format("Workload benchmark ({0}% reads of {1} blocks, "
+                           "{2} keys, {3} threads per worker)",
+                           read_ratio, op_blocks,
+                           option_value_name("key-dist", distribution),
+                           num_threads)
+            << std::endl;
+  for (const std::string &line : lines) {
+    csv << line << std::endl;
+    std::cout << line << std::endl;
+  }
+}
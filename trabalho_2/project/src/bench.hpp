@@ -0,0 +1,34 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include "lib.hpp"
+
+/**
+ * Measures how read throughput scales with the number of reader threads: for
+ * each thread count in 1, 2, 4 ... `BENCH_MAX_THREADS`, every worker runs that
+ * many threads reading random single blocks for `BENCH_ROUND_MILLIS`. Totals
+ * are reduced over `worker_comm` and reported by `MASTER_INSTANCE_ID`.
+ *
+ * Every block is read once beforehand and no writes are issued, so remote
+ * blocks are served from the local cache (by the message-based backend) as
+ * long as it can hold all of them; the cache counters of all workers are
+ * reported once every round is done
+ */
+void read_scaling_benchmark(UnifiedRepositoryFacade &repo);
+
+/**
+ * Runs a synthetic workload: every worker runs `BenchThreads` threads, each
+ * issuing operations over `OperationBlocks` consecutive blocks, reads with
+ * probability `ReadRatio`% and writes otherwise, starting at blocks picked by
+ * the `KeyDistribution` generator; threads stop after `OperationCount`
+ * operations each or, if 0, after `DurationMillis` (or
+ * `DEFAULT_WORKLOAD_DURATION_MILLIS`, if 0 as well).
+ *
+ * Each worker reports its operations and bytes per second, along with the
+ * 50th, 99th and 99.9th percentiles of operation latency, and
+ * `MASTER_INSTANCE_ID` reports the same over all of them (reducing their
+ * latency histograms), appending every row to `BENCH_CSV_PATH`
+ */
+void workload_benchmark(UnifiedRepositoryFacade &repo);
+
+#endif
@@ -4,15 +4,89 @@
 #define DEFAULT_BLOCK_SIZE 8
 #define DEFAULT_NUM_BLOCKS 4
 #define MAX_BLOCK_SIZE 32
-#define MAX_NUM_BLOCKS 32
+#define MAX_NUM_BLOCKS 1048576
+#define SLAB_ALIGNMENT 64
 #define MASTER_INSTANCE_ID 0
 #define MESSAGE_TAG_BLOCK_READ_REQUEST 100
-#define MESSAGE_TAG_BLOCK_READ_RESPONSE 101
 #define MESSAGE_TAG_BLOCK_WRITE_REQUEST 102
 #define MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION 103
+#define MESSAGE_TAG_BLOCK_INVALIDATION 104
+#define MESSAGE_TAG_BLOCK_FORWARDED_READ 105
+#define MESSAGE_TAG_BLOCK_FORWARDED_WRITE 106
+#define MESSAGE_TAG_BLOCK_MIGRATION 107
+#define MESSAGE_TAG_BLOCK_OWNERSHIP 108
+#define MESSAGE_TAG_BLOCK_REPLICA_UPDATE 109
+#define MESSAGE_TAG_SHUTDOWN 110
+#define MESSAGE_TAG_BLOCK_READ_RESPONSE_BASE 1024
+#define READ_REQUEST_ID_SPAN 16384
+#define MESSAGE_TAG_BLOCK_WRITE_ACK_BASE 17408
+#define WRITE_SEQUENCE_SPAN 8192
 #define OPERATION_SLEEP_INTERVAL_MILLIS 1000
+#define REQUEST_HANDLER_POOL_SIZE 4
+#define DISPATCHER_IDLE_SPINS 64
+#define DISPATCHER_IDLE_SLEEP_MICROS 50
+#define BLOCK_LOCK_STRIPES 64
 #define LOG_LEVEL_SPARSE 0
 #define LOG_LEVEL_REGULAR 1
 #define LOG_LEVEL_VERBOSE 2
+#define BACKEND_MESSAGE 0
+#define BACKEND_RMA 1
+#define DEFAULT_BACKEND BACKEND_MESSAGE
+#define MODE_RUN 0
+#define MODE_BENCH 1
+#define DEFAULT_MODE MODE_RUN
+#define BENCH_MAX_THREADS 8
+#define BENCH_ROUND_MILLIS 2000
+#define MODE_WORKLOAD 2
+#define KEY_DIST_UNIFORM 0
+#define KEY_DIST_ZIPFIAN 1
+#define KEY_DIST_SEQUENTIAL 2
+#define DEFAULT_KEY_DIST KEY_DIST_UNIFORM
+#define ZIPFIAN_THETA 0.99
+#define DEFAULT_READ_RATIO 50
+#define DEFAULT_OPERATION_BLOCKS 1
+#define DEFAULT_BENCH_THREADS 1
+#define DEFAULT_DURATION_MILLIS 0
+#define DEFAULT_WORKLOAD_DURATION_MILLIS 10000
+#define DEFAULT_OPERATION_COUNT 0
+#define LATENCY_SUB_BUCKET_BITS 5
+#define BENCH_DIR "bench"
+#define BENCH_CSV_PATH "bench/results.csv"
+#define DEFAULT_NOTIFICATION_BATCH_SIZE 64
+#define DEFAULT_NOTIFICATION_BATCH_WINDOW_MICROS 1000
+#define NOTIFICATION_RING_DEPTH 8
+#define NOTIFICATION_BATCH_CLOSED -1
+#define WRITE_THROUGH 0
+#define WRITE_BACK 1
+#define DEFAULT_WRITE_MODE WRITE_THROUGH
+#define DEFAULT_WRITE_BUFFER_SIZE 32
+#define DEFAULT_WRITE_BUFFER_WINDOW_MICROS 1000
+#define DEFAULT_WRITE_WINDOW 8
+#define COHERENCE_BROADCAST 0
+#define COHERENCE_DIRECTORY 1
+#define DEFAULT_COHERENCE COHERENCE_DIRECTORY
+#define BLOCK_VERSION_NONE 0
+#define CACHE_POLICY_CLOCK 0
+#define CACHE_POLICY_LRU 1
+#define DEFAULT_CACHE_POLICY CACHE_POLICY_CLOCK
+#define DEFAULT_CACHE_SIZE 0
+#define DEFAULT_PREFETCH_DEPTH 8
+#define PLACEMENT_CYCLIC 0
+#define PLACEMENT_RANGE 1
+#define PLACEMENT_HASH 2
+#define DEFAULT_PLACEMENT PLACEMENT_CYCLIC
+#define DEFAULT_PLACEMENT_CHUNK_SIZE 1
+#define CONSISTENT_HASH_VIRTUAL_NODES 64
+#define DEFAULT_MIGRATION_THRESHOLD 0
+#define DEFAULT_REPLICATION_FACTOR 1
+#define STORAGE_HEAP 0
+#define STORAGE_MMAP 1
+#define DEFAULT_STORAGE STORAGE_HEAP
+#define STORAGE_DIR "data"
+#define DEFAULT_RESTORE 0
+#define DEFAULT_CHECKPOINT_INTERVAL 0
+#define IMAGE_PATH "data/blocks.img"
+#define DEFAULT_LOAD 0
+#define DEFAULT_DUMP_INTERVAL 0
 
 #endif
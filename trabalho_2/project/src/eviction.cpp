@@ -0,0 +1,89 @@
+#include "eviction.hpp"
+#include "constants.hpp"
+#include <format>
+#include <stdexcept>
+
+ClockPolicy::ClockPolicy(int capacity)
+    : referenced(capacity), tracked(capacity, false), hand(0) {}
+
+void ClockPolicy::insert(int slot) {
+  tracked.at(slot) = true;
+  referenced[slot].store(true, std::memory_order_relaxed);
+}
+
+void ClockPolicy::touch(int slot) {
+  referenced.at(slot).store(true, std::memory_order_relaxed);
+}
+
+/**
+ * Every slot may need its reference bit cleared before being offered, so two
+ * full sweeps are enough to offer all of them
+ */
+int ClockPolicy::victim(const std::function<bool(int)> &evict) {
+  int capacity = tracked.size();
+
+  for (int step = 0; step < 2 * capacity; step++) {
+    int slot = hand;
+    hand = (hand + 1) % capacity;
+
+    if (!tracked[slot])
+      continue;
+
+    if (referenced[slot].exchange(false, std::memory_order_relaxed))
+      continue;
+
+    if (evict(slot)) {
+      tracked[slot] = false;
+      return slot;
+    }
+  }
+
+  return -1;
+}
+
+LruPolicy::LruPolicy(int capacity)
+    : positions(capacity), tracked(capacity, false) {}
+
+void LruPolicy::insert(int slot) {
+  std::lock_guard lock(mtx);
+  if (tracked.at(slot))
+    order.erase(positions[slot]);
+
+  order.push_front(slot);
+  positions[slot] = order.begin();
+  tracked[slot] = true;
+}
+
+void LruPolicy::touch(int slot) {
+  std::lock_guard lock(mtx);
+  if (tracked.at(slot))
+    order.splice(order.begin(), order, positions[slot]);
+}
+
+int LruPolicy::victim(const std::function<bool(int)> &evict) {
+  std::lock_guard lock(mtx);
+
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    int slot = *it;
+    if (evict(slot)) {
+      order.erase(positions[slot]);
+      tracked[slot] = false;
+      return slot;
+    }
+  }
+
+  return -1;
+}
+
+std::unique_ptr<EvictionPolicy> make_eviction_policy(int policy,
+                                                     int capacity) {
+  switch (policy) {
+  case CACHE_POLICY_CLOCK:
+    return std::make_unique<ClockPolicy>(capacity);
+  case CACHE_POLICY_LRU:
+    return std::make_unique<LruPolicy>(capacity);
+  default:
+    throw std::runtime_error(
+        std::format("Unknown cache eviction policy {0}", policy));
+  }
+}
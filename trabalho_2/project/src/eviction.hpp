@@ -0,0 +1,82 @@
+#ifndef __EVICTION_H__
+#define __EVICTION_H__
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Replacement policy over the `capacity` slots of a bounded cache. Slots are
+ * reported through `insert` once filled and `touch` on every hit; `victim`
+ * picks the slot to be reused next.
+ *
+ * `touch` may be called concurrently with any other method, while `insert` and
+ * `victim` must be serialized by the caller
+ */
+class EvictionPolicy {
+public:
+  /**
+   * Start tracking `slot`, which was just filled
+   */
+  virtual void insert(int slot) = 0;
+
+  /**
+   * Record a hit on `slot`
+   */
+  virtual void touch(int slot) = 0;
+
+  /**
+   * Offer tracked slots to `evict`, in eviction order, until it accepts one
+   * (returning `true`), which is then no longer tracked and is returned;
+   * returns -1 if every slot was refused
+   */
+  virtual int victim(const std::function<bool(int)> &evict) = 0;
+  virtual ~EvictionPolicy() = default;
+};
+
+/**
+ * CLOCK (second chance) policy: hits only set a per-slot reference bit, so
+ * they take no locks; `victim` sweeps a hand over the slots, clearing set bits
+ * and offering the first slot found clear
+ */
+class ClockPolicy : public EvictionPolicy {
+public:
+  ClockPolicy(int capacity);
+  void insert(int slot) override;
+  void touch(int slot) override;
+  int victim(const std::function<bool(int)> &evict) override;
+
+private:
+  std::vector<std::atomic<bool>> referenced;
+  std::vector<bool> tracked;
+  int hand;
+};
+
+/**
+ * Least-recently-used policy: slots are kept in recency order, which every hit
+ * updates under a mutex; `victim` offers the least recently used slots first
+ */
+class LruPolicy : public EvictionPolicy {
+public:
+  LruPolicy(int capacity);
+  void insert(int slot) override;
+  void touch(int slot) override;
+  int victim(const std::function<bool(int)> &evict) override;
+
+private:
+  std::mutex mtx;
+  std::list<int> order;
+  std::vector<std::list<int>::iterator> positions;
+  std::vector<bool> tracked;
+};
+
+/**
+ * Builds the policy identified by `policy` (one of the `CACHE_POLICY_*`
+ * constants) over `capacity` slots
+ */
+std::unique_ptr<EvictionPolicy> make_eviction_policy(int policy, int capacity);
+
+#endif
@@ -2,88 +2,650 @@
 #define __LIB_H__
 
 #include "constants.hpp"
+#include "eviction.hpp"
 #include "logger.hpp"
+#include "migration.hpp"
 #include "mpi.h"
+#include "prefetch.hpp"
+#include "slab.hpp"
 #include "store.hpp"
 #include "types.hpp"
 #include "utils.hpp"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <deque>
 #include <format>
+#include <fstream>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <set>
 #include <shared_mutex>
+#include <span>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 class IRepository {
 public:
-  virtual block read(int key) = 0;
+  virtual void read(int key, std::span<uint8_t> dest) = 0;
+  virtual void read(const std::vector<int> &keys, std::span<uint8_t> dest) = 0;
   virtual void write(int key, block value) = 0;
+  virtual void write(const std::vector<WriteMessageBuffer> &entries) = 0;
   virtual std::map<int, block> dump() = 0;
 };
 
+/**
+ * Repository for blocks maintained by the other processes, which may be read
+ * asynchronously
+ */
+class IRemoteRepository : public IRepository {
+public:
+  virtual void invalidate_cache(int key) = 0;
+
+  /**
+   * Clear locally cached data for block indexed by `key`, written by its
+   * maintainer at `version`, unless the cached copy is at least that recent
+   */
+  virtual void invalidate_cache(int key, block_version version) = 0;
+
+  /**
+   * Counters of the local cache of remote blocks
+   */
+  virtual CacheStats cache_stats() = 0;
+
+  /**
+   * Start fetching block indexed by `key`, without waiting for its contents
+   */
+  virtual std::future<block> read_async(int key) = 0;
+
+  /**
+   * Start fetching every block indexed by `keys`, without waiting for their
+   * contents
+   */
+  virtual std::vector<std::future<block>>
+  read_async(const std::vector<int> &keys) = 0;
+
+  /**
+   * Start fetching every block indexed by `keys` into the local cache, in the
+   * background; blocks already cached, or with writes still pending, are
+   * skipped
+   */
+  virtual void prefetch(const std::vector<int> &keys) = 0;
+
+  /**
+   * Advance outstanding remote fetches (and buffered writes); returns `true`
+   * while any are pending
+   */
+  virtual bool progress() = 0;
+
+  /**
+   * Send out every buffered write, returning once all outstanding writes were
+   * applied by their maintainers
+   */
+  virtual void fence() = 0;
+};
+
 /**
  * Wrapper class for the process-local memory-blocks - that is - the memory
  * blocks that are maintained by the local process.
+ *
+ * Every slot is published through a sequence counter (seqlock): readers take
+ * no locks, retrying their copy whenever a write to the same slot overlapped
+ * it, while writers to the same slot are serialized by `BLOCK_LOCK_STRIPES`
+ * striped mutexes. The counter doubles as the version of the block, which is
+ * attached to invalidations and READ responses.
+ *
+ * Under directory-based coherence, every slot also records the processes that
+ * fetched it (its sharers), so that writes only invalidate their caches.
+ *
+ * Blocks may migrate in and out (see `adopt` and `release`); when migration is
+ * enabled, the slab has room for every block, so that blocks can always be
+ * adopted.
+ *
+ * When replication is enabled, the slab also holds the read replicas of blocks
+ * maintained elsewhere, which their maintainer keeps up to date (see
+ * `replicate`); every write to a block maintained here is pushed to its
+ * replicas before sharers are invalidated.
+ *
+ * When persistence is enabled, the slab is a mapping of a file under
+ * `STORAGE_DIR`, which `checkpoint` writes through along with a manifest of the
+ * key and sequence of every slot; with `Restore` set, both are picked up on
+ * construction instead of starting from zeroed blocks (and replicas are then
+ * pushed every block again, see `resync_replicas`)
  */
 class LocalRepository : public IRepository {
 public:
   LocalRepository(memory_map mem_map, int block_size, int world_rank);
-  block read(int key) override;
+  void read(int key, std::span<uint8_t> dest) override;
+  void read(const std::vector<int> &keys, std::span<uint8_t> dest) override;
   void write(int key, block value) override;
+  void write(const std::vector<WriteMessageBuffer> &entries) override;
   std::map<int, block> dump() override;
+
+  /**
+   * Read contents from block indexed by `key` into `dest`, returning the
+   * version they were read at
+   */
+  block_version read_versioned(int key, std::span<uint8_t> dest);
+
+  /**
+   * Record process `sharer` as caching every block indexed by `keys`; must be
+   * called before the blocks are read on its behalf
+   */
+  void add_sharer(const std::vector<int> &keys, int sharer);
+
+  /**
+   * Start maintaining block indexed by `key`, migrated here at `version` with
+   * contents `data`
+   */
+  void adopt(int key, block_version version, block data);
+
+  /**
+   * Stop maintaining block indexed by `key`, returning its contents along with
+   * their version; no other operation on the block may be under way
+   */
+  std::pair<block_version, block> release(int key);
+
+  /**
+   * Apply every block of `batch`, pushed by its maintainer, to the replica
+   * held here, unless the replica is already at least as recent
+   */
+  void replicate(const ReplicaUpdateBatch &batch);
+
+  /**
+   * Push every block maintained here to its read replicas, bringing those
+   * restored from an older checkpoint up to date
+   */
+  void resync_replicas();
+
+  /**
+   * Persist every block held here to the file backing the slab, along with
+   * its version; throws unless persistence is enabled
+   */
+  void checkpoint();
+
+  /**
+   * Overwrite every block indexed by `keys` (maintained here) with consecutive
+   * blocks of `contents`, in order, pushing them to their read replicas.
+   * Sharers are dropped without being invalidated: every other process must
+   * invalidate its cached copies on its own
+   */
+  void load(const std::vector<int> &keys, block_view contents);
   ~LocalRepository();
 
 private:
+  void restore();
+  void notify(int key, block_version version);
+  void push_replicas(const std::map<int, block_version> &written);
+  void invalidate_sharers(const std::map<int, block_version> &written);
+  int slot_of(int key) const;
+  block_version read_slot(int slot, std::span<uint8_t> dest);
+  block_version write_slot(int slot, int offset, block_view src);
+
   memory_map mem_map;
-  std::map<int, block> blocks;
-  std::shared_mutex mtx;
+  BlockSlab slab;
+  std::vector<int> slots;
+  std::vector<std::atomic<uint32_t>> sequences;
+  std::vector<std::set<int>> sharers;
+  std::array<std::mutex, BLOCK_LOCK_STRIPES> write_stripes;
+  std::vector<int> free_slots;
+  std::mutex slots_mtx;
+  std::string path;
   int block_size;
+  int world_rank;
 };
 
+/**
+ * Resolves the file backing the slab of process `world_rank` (creating its
+ * directory), or an empty path if blocks are kept in heap memory
+ */
+inline std::string resolve_slab_path(int world_rank) {
+  if (!is_persistence_enabled())
+    return "";
+
+  create_directory(STORAGE_DIR);
+  return get_storage_path(world_rank);
+}
+
+/**
+ * Resolves the blocks process `world_rank` holds read replicas of
+ */
+inline std::vector<int> resolve_replica_keys(int world_rank) {
+  std::vector<int> keys;
+  if (!is_replication_enabled())
+    return keys;
+
+  for (int key = 0; key < registry_get(GlobalRegistryIndex::NumBlocks); key++)
+    if (is_replica_holder(key, world_rank))
+      keys.push_back(key);
+
+  return keys;
+}
+
 inline LocalRepository::LocalRepository(memory_map mem_map, int block_size,
                                         int world_rank)
-    : mem_map(mem_map), blocks(std::map<int, block>()), block_size(block_size) {
-  for (int i : mem_map.at(world_rank)) {
-    block b = std::make_shared<std::uint8_t[]>(block_size);
-    std::fill_n(b.get(), block_size, 0);
+    : mem_map(mem_map),
+      slab(is_migration_enabled()
+               ? registry_get(GlobalRegistryIndex::NumBlocks)
+               : static_cast<int>(mem_map.at(world_rank).size() +
+                                  resolve_replica_keys(world_rank).size()),
+           block_size, resolve_slab_path(world_rank), is_restore_enabled()),
+      slots(registry_get(GlobalRegistryIndex::NumBlocks), -1),
+      sequences(slab.capacity()), sharers(slab.capacity()),
+      path(resolve_slab_path(world_rank)), block_size(block_size),
+      world_rank(world_rank) {
+  int slot = 0;
+  for (int i : mem_map.at(world_rank))
+    slots.at(i) = slot++;
+  for (int i : resolve_replica_keys(world_rank))
+    slots.at(i) = slot++;
 
-    blocks.emplace(i, b);
-  }
+  for (int i = slab.capacity() - 1; i >= slot; i--)
+    free_slots.push_back(i);
+
+  if (is_restore_enabled())
+    restore();
 }
 
 inline LocalRepository::~LocalRepository() = default;
 
 /**
- * Read contents from block indexed by `key`
+ * Version of a block whose slot sequence is `sequence` (even), that is, one
+ * more than the number of writes it has seen
+ */
+inline block_version version_of_sequence(uint32_t sequence) {
+  return sequence / 2 + 1;
+}
+
+/**
+ * Copies the block stored at `slot` into `dest`, returning its version; the
+ * copy is retried until no write overlapped it, that is, until the slot's
+ * sequence was even and unchanged across the copy
+ */
+inline block_version LocalRepository::read_slot(int slot,
+                                                std::span<uint8_t> dest) {
+  std::atomic<uint32_t> &sequence = sequences[slot];
+  uint32_t before, after;
+
+  while (true) {
+    before = sequence.load(std::memory_order_acquire);
+    if (before % 2 == 0) {
+      copy_block(slab.at(slot), dest);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+
+      if (before == after)
+        return version_of_sequence(before);
+    }
+
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * Copies `src` into the block stored at `slot`, starting at byte `offset`, and
+ * returns the new version of the block; the slot's sequence is odd while the
+ * copy is in progress
  */
-inline block LocalRepository::read(int key) {
-  std::shared_lock lock(mtx);
+inline block_version LocalRepository::write_slot(int slot, int offset,
+                                                 block_view src) {
+  std::lock_guard lock(write_stripes[slot % BLOCK_LOCK_STRIPES]);
+  std::atomic<uint32_t> &sequence = sequences[slot];
+  uint32_t current = sequence.load(std::memory_order_relaxed);
+
+  sequence.store(current + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  copy_block(src, slab.at(slot).subspan(offset));
+  sequence.store(current + 2, std::memory_order_release);
+
+  return version_of_sequence(current + 2);
+}
+
+/**
+ * Resolves the slab slot holding block indexed by `key`
+ */
+inline int LocalRepository::slot_of(int key) const {
+  if (key < 0 || key >= static_cast<int>(slots.size()) || slots[key] < 0)
+    throw std::runtime_error("Bad index");
+
+  return slots[key];
+}
+
+/**
+ * Read contents from block indexed by `key` into `dest`
+ */
+inline void LocalRepository::read(int key, std::span<uint8_t> dest) {
   thread_safe_log_with_id(std::format(
       "READ operation to block {0} called at local repository level", key));
-  auto it = blocks.find(key);
-  if (it == blocks.end())
-    throw std::runtime_error("Bad index");
 
-  block copy = std::make_shared<std::uint8_t[]>(block_size);
-  std::copy_n(it->second.get(), block_size, copy.get());
+  read_slot(slot_of(key), dest);
+}
 
-  return copy;
+inline block_version LocalRepository::read_versioned(int key,
+                                                     std::span<uint8_t> dest) {
+  return read_slot(slot_of(key), dest);
+}
+
+/**
+ * Read contents from every block indexed by `keys` into consecutive blocks of
+ * `dest`, in order; each block is read consistently on its own
+ */
+inline void LocalRepository::read(const std::vector<int> &keys,
+                                  std::span<uint8_t> dest) {
+  thread_safe_log_with_id(std::format(
+      "READ operation to blocks {0} called at local repository level",
+      print_vec(keys)));
+
+  for (size_t i = 0; i < keys.size(); i++)
+    read_slot(slot_of(keys[i]), block_subspan(dest, i));
 }
 
 /**
  * Write `value` to memory block identified by `key`
  */
 inline void LocalRepository::write(int key, block value) {
-  {
-    std::unique_lock lock(mtx);
+  write({WriteMessageBuffer(key, value, 0, block_size)});
+}
+
+/**
+ * Write every entry of `entries` to the byte range of its memory block, in
+ * order
+ */
+inline void
+LocalRepository::write(const std::vector<WriteMessageBuffer> &entries) {
+  std::map<int, block_version> written;
+
+  for (const WriteMessageBuffer &entry : entries) {
+    thread_safe_log_with_id(std::format(
+        "WRITE operation to bytes {0} through {1} of block {2} called at local "
+        "repository level",
+        entry.offset, entry.offset + entry.length - 1, entry.key));
+
+    if (!is_valid_write_range(entry))
+      throw std::runtime_error("Bad range");
+
+    written[entry.key] =
+        write_slot(slot_of(entry.key), entry.offset,
+                   block_view(entry.data.get(), entry.length));
+  }
+
+  if (is_replication_enabled())
+    push_replicas(written);
+
+  if (registry_get(GlobalRegistryIndex::Coherence) == COHERENCE_DIRECTORY) {
+    invalidate_sharers(written);
+    return;
+  }
+
+  for (auto &[key, version] : written)
+    notify(key, version);
+}
+
+inline void LocalRepository::add_sharer(const std::vector<int> &keys,
+                                        int sharer) {
+  for (int key : keys) {
+    int slot = slot_of(key);
+    std::lock_guard lock(write_stripes[slot % BLOCK_LOCK_STRIPES]);
+    sharers[slot].insert(sharer);
+  }
+}
+
+/**
+ * Send out a single INVALIDATION message to every sharer of the blocks in
+ * `written`, carrying the keys it shared along with the version each block was
+ * written at, and clear their sharer sets; the sets are taken after the blocks
+ * were written, so any process recorded later reads the new contents
+ */
+inline void LocalRepository::invalidate_sharers(
+    const std::map<int, block_version> &written) {
+  std::map<int, NotificationBatch> invalidations;
+
+  for (auto &[key, version] : written) {
+    int slot = slot_of(key);
+    std::lock_guard lock(write_stripes[slot % BLOCK_LOCK_STRIPES]);
+    for (int sharer : sharers[slot]) {
+      invalidations[sharer].keys.push_back(key);
+      invalidations[sharer].versions.push_back(version);
+    }
+    sharers[slot].clear();
+  }
+
+  for (auto &[sharer, batch] : invalidations) {
+    int count = batch.keys.size();
+    thread_safe_log_with_id(std::format(
+        "Sending out INVALIDATION for blocks {0} to process of ID {1}...",
+        print_vec(batch.keys), sharer));
+
+    std::shared_ptr<uint8_t[]> data = encode_notification_batch(batch, count);
+    int send_result = MPI_Send(
+        data.get(), get_total_notification_batch_buffer_size(count),
+        MPI_UNSIGNED_CHAR, sharer, MESSAGE_TAG_BLOCK_INVALIDATION,
+        request_comm());
+
+    if (send_result != MPI_SUCCESS)
+      throw std::runtime_error("Encountered unexpected exception at `handler` "
+                               "level while attempting to perform "
+                               "INVALIDATION request");
+  }
+}
+
+/**
+ * Send out a single REPLICA UPDATE message to every process holding a replica
+ * of the blocks in `written`, carrying their current contents; blocks are read
+ * again (consistently), so each is pushed along with the version of the
+ * contents sent, which may already be newer than the one written here
+ */
+inline void
+LocalRepository::push_replicas(const std::map<int, block_version> &written) {
+  std::map<int, std::vector<int>> updates;
+  for (auto &[key, version] : written) {
+    std::vector<int> replicas = resolve_replicas(key);
+    for (size_t i = 1; i < replicas.size(); i++)
+      updates[replicas[i]].push_back(key);
+  }
+
+  for (auto &[holder, keys] : updates) {
+    int count = keys.size();
+    ReplicaUpdateBatch batch{keys, std::vector<block_version>(count),
+                             std::make_shared<uint8_t[]>(count * block_size)};
+    for (int i = 0; i < count; i++)
+      batch.versions[i] = read_slot(
+          slot_of(keys[i]),
+          std::span<uint8_t>(batch.contents.get() + i * block_size,
+                             block_size));
+
     thread_safe_log_with_id(std::format(
-        "WRITE operation to block {0} called at local repository level", key));
-    blocks[key] = value;
+        "Pushing blocks {0} at versions {1} to replica at process of ID {2}...",
+        print_vec(keys), print_vec(batch.versions), holder));
+
+    int send_result =
+        MPI_Send(encode_replica_update(batch).get(),
+                 get_total_replica_update_buffer_size(count),
+                 MPI_UNSIGNED_CHAR, holder, MESSAGE_TAG_BLOCK_REPLICA_UPDATE,
+                 request_comm());
+
+    if (send_result != MPI_SUCCESS)
+      throw std::runtime_error("Encountered unexpected exception at `handler` "
+                               "level while attempting to perform REPLICA "
+                               "UPDATE request");
+  }
+}
+
+/**
+ * Replicas are written under the seqlock protocol, as any other block, but
+ * their sequence jumps straight to the one matching the pushed version; only
+ * sharers of the replica itself are invalidated (under directory-based
+ * coherence), since the maintainer already notified or invalidated its own
+ */
+inline void LocalRepository::replicate(const ReplicaUpdateBatch &batch) {
+  std::map<int, block_version> written;
+
+  for (size_t i = 0; i < batch.keys.size(); i++) {
+    int key = batch.keys[i];
+    if (!is_replica_holder(key, world_rank))
+      throw std::runtime_error("Bad index");
+
+    int slot = slot_of(key);
+    std::lock_guard lock(write_stripes[slot % BLOCK_LOCK_STRIPES]);
+    std::atomic<uint32_t> &sequence = sequences[slot];
+    uint32_t current = sequence.load(std::memory_order_relaxed);
+    if (batch.versions[i] <= version_of_sequence(current))
+      continue;
+
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    copy_block(block_view(batch.contents.get() + i * block_size, block_size),
+               slab.at(slot));
+    sequence.store(2 * (batch.versions[i] - 1), std::memory_order_release);
+    written[key] = batch.versions[i];
+  }
+
+  thread_safe_log_with_id(std::format(
+      "Applied {0} of {1} pushed blocks {2} to local replicas", written.size(),
+      batch.keys.size(), print_vec(batch.keys)));
+
+  if (registry_get(GlobalRegistryIndex::Coherence) == COHERENCE_DIRECTORY)
+    invalidate_sharers(written);
+}
+
+inline void LocalRepository::resync_replicas() {
+  if (!is_replication_enabled())
+    return;
+
+  std::map<int, block_version> maintained;
+  for (int key : mem_map.at(world_rank))
+    maintained[key] = version_of_sequence(sequences[slot_of(key)].load());
+
+  push_replicas(maintained);
+}
+
+/**
+ * The manifest is laid out as
+ * `[ int block_size ][ int capacity ][ int key ] * capacity [ uint32_t sequence ] * capacity`
+ * (a key of -1 marking a free slot), and replaces the previous one at once, by
+ * renaming, so that an interrupted checkpoint leaves the last one intact.
+ * Writes are held off meanwhile, so that the manifest matches the contents
+ */
+inline void LocalRepository::checkpoint() {
+  if (!slab.is_mapped())
+    throw std::runtime_error("Blocks are not backed by a file");
+
+  std::lock_guard lock(slots_mtx);
+  std::vector<std::unique_lock<std::mutex>> writers;
+  for (std::mutex &stripe : write_stripes)
+    writers.emplace_back(stripe);
+
+  int capacity = slab.capacity();
+  std::vector<int> keys(capacity, -1);
+  std::vector<uint32_t> snapshot(capacity);
+  for (size_t key = 0; key < slots.size(); key++)
+    if (slots[key] >= 0)
+      keys[slots[key]] = key;
+  for (int slot = 0; slot < capacity; slot++)
+    snapshot[slot] = sequences[slot].load(std::memory_order_acquire);
+
+  slab.sync();
+
+  std::string manifest = path + ".meta";
+  {
+    std::ofstream out(manifest + ".tmp", std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&block_size), sizeof(int));
+    out.write(reinterpret_cast<const char *>(&capacity), sizeof(int));
+    out.write(reinterpret_cast<const char *>(keys.data()),
+              capacity * sizeof(int));
+    out.write(reinterpret_cast<const char *>(snapshot.data()),
+              capacity * sizeof(uint32_t));
+    out.flush();
+
+    if (!out)
+      throw std::runtime_error(
+          std::format("Failed to write checkpoint manifest {0}", manifest));
+  }
+
+  if (std::rename((manifest + ".tmp").c_str(), manifest.c_str()) != 0)
+    throw std::runtime_error(
+        std::format("Failed to replace checkpoint manifest {0}", manifest));
+
+  thread_safe_log_with_id(std::format("Checkpointed {0} blocks to {1}",
+                                      capacity - free_slots.size(), path));
+}
+
+/**
+ * The manifest must list the very blocks assigned to this process, slot by
+ * slot (so the block size, placement and replication are those of the run
+ * that wrote it, and no block had migrated); their sequences are restored, so
+ * that versions keep growing across runs. The file itself always holds the
+ * latest contents, which may include writes made after the checkpoint, so
+ * blocks maintained here are restored one version ahead, which every replica
+ * (persisted at most at the checkpointed version) then gets pushed
+ */
+inline void LocalRepository::restore() {
+  std::string manifest = path + ".meta";
+  std::ifstream in(manifest, std::ios::binary);
+  int stored_block_size = 0, capacity = 0;
+  in.read(reinterpret_cast<char *>(&stored_block_size), sizeof(int));
+  in.read(reinterpret_cast<char *>(&capacity), sizeof(int));
+
+  std::vector<int> expected(slab.capacity(), -1);
+  for (size_t key = 0; key < slots.size(); key++)
+    if (slots[key] >= 0)
+      expected[slots[key]] = key;
+
+  std::vector<int> keys;
+  std::vector<uint32_t> snapshot;
+  if (in && stored_block_size == block_size && capacity == slab.capacity()) {
+    keys.resize(capacity);
+    snapshot.resize(capacity);
+    in.read(reinterpret_cast<char *>(keys.data()), capacity * sizeof(int));
+    in.read(reinterpret_cast<char *>(snapshot.data()),
+            capacity * sizeof(uint32_t));
+  }
+
+  if (!in || keys != expected)
+    throw std::runtime_error(std::format(
+        "No checkpoint matching the current block layout at {0}", manifest));
+
+  for (int slot = 0; slot < capacity; slot++) {
+    bool replica = keys[slot] >= 0 && is_replica_holder(keys[slot], world_rank);
+    sequences[slot].store(snapshot[slot] + (replica ? 0 : 2),
+                          std::memory_order_relaxed);
+  }
+
+  thread_safe_log_with_id(std::format("Restored blocks from {0}", path));
+}
+
+inline void LocalRepository::load(const std::vector<int> &keys,
+                                  block_view contents) {
+  std::map<int, block_version> written;
+  for (size_t i = 0; i < keys.size(); i++) {
+    int slot = slot_of(keys[i]);
+    written[keys[i]] =
+        write_slot(slot, 0, contents.subspan(i * block_size, block_size));
+
+    std::lock_guard lock(write_stripes[slot % BLOCK_LOCK_STRIPES]);
+    sharers[slot].clear();
   }
 
+  if (is_replication_enabled())
+    push_replicas(written);
+
+  thread_safe_log_with_id(
+      std::format("Loaded {0} blocks into local repository", keys.size()));
+}
+
+/**
+ * Send out an update notification for block identified by `key`, written at
+ * `version`, to the broadcaster instance
+ */
+inline void LocalRepository::notify(int key, block_version version) {
   long timestamp = std::chrono::duration_cast<std::chrono::seconds>(
                        std::chrono::system_clock::now().time_since_epoch())
                        .count();
@@ -91,14 +653,14 @@ inline void LocalRepository::write(int key, block value) {
   thread_safe_log_with_id(std::format(
       "Sending out update notification request for block {0}...", key));
 
-  NotificationMessageBuffer message(key, timestamp);
+  NotificationMessageBuffer message(key, version, timestamp);
   std::shared_ptr<uint8_t[]> data = encode_notification_message(message);
 
   int send_result = MPI_Send(
       data.get(), get_total_notification_message_buffer_size(),
       MPI_UNSIGNED_CHAR,
       get_broadcaster_proc_rank(registry_get(GlobalRegistryIndex::WorldSize)),
-      MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION, MPI_COMM_WORLD);
+      MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION, request_comm());
 
   if (send_result != MPI_SUCCESS)
     throw std::runtime_error("Encountered unexpected exception at `handler` "
@@ -106,17 +668,54 @@ inline void LocalRepository::write(int key, block value) {
                              "to perform NOTIFICATION request");
 }
 
+/**
+ * The slot's sequence is set to match `version`, so that the versions of the
+ * block keep growing across maintainers
+ */
+inline void LocalRepository::adopt(int key, block_version version, block data) {
+  std::lock_guard lock(slots_mtx);
+  if (slots.at(key) >= 0 || free_slots.empty())
+    throw std::runtime_error("Bad index");
+
+  int slot = free_slots.back();
+  free_slots.pop_back();
+
+  copy_block(block_view(data.get(), block_size), slab.at(slot));
+  sequences[slot].store(2 * (version - 1), std::memory_order_release);
+  sharers[slot].clear();
+  slots[key] = slot;
+}
+
+/**
+ * Sharers of the block are dropped along with it, since the migration is
+ * announced to every process, which invalidate their copies
+ */
+inline std::pair<block_version, block> LocalRepository::release(int key) {
+  std::lock_guard lock(slots_mtx);
+  int slot = slot_of(key);
+  block data = std::make_shared<uint8_t[]>(block_size);
+  block_version version =
+      read_slot(slot, std::span<uint8_t>(data.get(), block_size));
+
+  slots[key] = -1;
+  sharers[slot].clear();
+  free_slots.push_back(slot);
+  return {version, data};
+}
+
 /**
  * Export a static representation of the current stored state (for debug and
  * logging purposes)
  */
 inline std::map<int, block> LocalRepository::dump() {
-  std::shared_lock lock(mtx);
+  std::lock_guard lock(slots_mtx);
   std::map<int, block> copy;
-  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
-  for (const auto &[key, ptr] : blocks) {
+  for (size_t key = 0; key < slots.size(); key++) {
+    if (slots[key] < 0 || is_replica_holder(key, world_rank))
+      continue;
+
     block new_buf = std::make_shared<uint8_t[]>(block_size);
-    std::memcpy(new_buf.get(), ptr.get(), block_size);
+    read_slot(slots[key], std::span<uint8_t>(new_buf.get(), block_size));
     copy[key] = new_buf;
   }
 
@@ -126,206 +725,2085 @@ inline std::map<int, block> LocalRepository::dump() {
 /**
  * Wrapper class for the remote memory-blocks - that is - the memory
  * blocks that are maintained by the other processes.
+ *
+ * Fetched blocks are cached in a slab bounded by `CacheSize` bytes (unbounded,
+ * that is, able to hold every remote block, when 0); once it is full, every new
+ * block takes the slot of the victim picked by the `CachePolicy` eviction
+ * policy. Blocks may also be fetched ahead of time with `prefetch`, in which
+ * case they are counted as useful once read from the cache, and as wasted if
+ * they leave it before that.
+ *
+ * Cache entries are guarded by `BLOCK_LOCK_STRIPES` striped locks (by key), so
+ * fills, invalidations and reads of unrelated blocks never contend; no lock is
+ * held across MPI calls. Evictions only take the victim's stripe if it is free,
+ * skipping to the next candidate otherwise.
+ *
+ * Every cached copy is tagged with the version it was read at. Invalidations
+ * only mark a copy stale, keeping its contents: a later miss sends that version
+ * along with the READ request, and the maintainer answers with the version
+ * alone while the block is unchanged. Invalidations carrying a version no newer
+ * than the cached one (stale or reordered) are ignored.
+ *
+ * In write-back mode, writes are combined per maintainer and block (the last
+ * write to a block wins) and sent out once the buffer holds `WriteBufferSize`
+ * blocks, once `WriteBufferWindowMicros` elapse, or on `fence`; reads of
+ * buffered blocks are served from the buffer.
+ *
+ * Every WRITE request carries a sequence number that its maintainer echoes back
+ * once the write is applied. Up to `WriteWindow` requests per maintainer may be
+ * unacknowledged at once, a block is never part of two of them (so writes to
+ * the same block are applied in order), and reads of a block wait for its
+ * acknowledgement.
+ *
+ * Concurrent misses on the same block are served by a single fetch: only the
+ * first one issues a READ, and the others wait for its response, unless the
+ * block was invalidated after that READ was issued.
+ *
+ * When replication is enabled, misses are sent to whichever copy of the block
+ * (its maintainer or a read replica) has the fewest keys in flight from this
+ * process. Replicas lag behind their maintainer, so blocks written by this
+ * process are fetched from their maintainer until it answers, and replicas
+ * answering with a version older than the latest invalidation of the block are
+ * asked again to its maintainer
  */
-class RemoteRepository : public IRepository {
+class RemoteRepository : public IRemoteRepository {
 public:
   RemoteRepository(memory_map mem_map, int block_size, int world_rank);
-  block read(int key) override;
+  void read(int key, std::span<uint8_t> dest) override;
+  void read(const std::vector<int> &keys, std::span<uint8_t> dest) override;
   void write(int key, block value) override;
+  void write(const std::vector<WriteMessageBuffer> &entries) override;
   std::map<int, block> dump() override;
-  void invalidate_cache(int key);
+  void invalidate_cache(int key) override;
+  void invalidate_cache(int key, block_version version) override;
+  CacheStats cache_stats() override;
+  std::future<block> read_async(int key) override;
+
+  /**
+   * Start fetching every block indexed by `keys`, without waiting for their
+   * contents; blocks are requested with a single READ message per maintainer
+   */
+  std::vector<std::future<block>>
+  read_async(const std::vector<int> &keys) override;
+  void prefetch(const std::vector<int> &keys) override;
+  bool progress() override;
+  void fence() override;
   ~RemoteRepository();
 
 private:
+  /**
+   * Entry of the in-flight table: a single READ message to `target`, carrying
+   * `keys`, along with the `promises` to fulfill once the response arrives
+   */
+  struct PendingRead {
+    int target;
+    int request_id;
+    std::vector<int> keys;
+    std::vector<block_version> versions;
+    std::vector<block> stale_copies;
+    std::vector<uint32_t> generations;
+    bool prefetch;
+    std::vector<std::promise<block>> promises;
+    std::shared_ptr<uint8_t[]> request_buffer;
+    std::shared_ptr<uint8_t[]> response_buffer;
+    std::array<MPI_Request, 2> requests;
+  };
+
+  /**
+   * Lock guarding the cache entry of every block `k` such that
+   * `k % BLOCK_LOCK_STRIPES` matches its index; aligned so that neighbouring
+   * stripes do not share cache lines
+   */
+  struct alignas(SLAB_ALIGNMENT) LockStripe {
+    std::shared_mutex mtx;
+  };
+
+  /**
+   * Entry of the single-flight table: the fetch of a block issued at its
+   * `generation`, along with the promises of the `followers` waiting for it
+   */
+  struct InFlightFetch {
+    uint32_t generation;
+    std::vector<std::promise<block>> followers;
+  };
+
+  /**
+   * Block of the write buffer: the bytes written to it so far are flagged in
+   * `dirty`, `dirty_bytes` of them being set
+   */
+  struct BufferedWrite {
+    block data;
+    std::vector<bool> dirty;
+    int dirty_bytes;
+  };
+
+  /**
+   * Entry of the unacknowledged write table: a single WRITE message to
+   * `target`, carrying `keys`, along with the receive for its acknowledgement
+   */
+  struct PendingWrite {
+    int target;
+    int sequence;
+    std::vector<int> keys;
+    std::shared_ptr<uint8_t[]> message_buffer;
+    std::shared_ptr<uint8_t[]> ack_buffer;
+    std::array<MPI_Request, 2> requests;
+  };
+
+  void issue(PendingRead &pending);
+  void submit(std::map<int, std::shared_ptr<PendingRead>> &reads);
+  void enqueue(const std::shared_ptr<PendingRead> &pending);
+  void complete(PendingRead &pending,
+                std::vector<std::shared_ptr<PendingRead>> &retries);
+  int route(int key);
+  void fill(int key, block data, block_version version, uint32_t generation,
+            bool prefetch);
+  void count_wasted_prefetch(int key);
+  bool join_fetch(int key, std::promise<block> *promise);
+  void release_followers(int key, uint32_t generation, block data);
+  int allocate_slot(int key);
+  void check_key(int key) const;
+  std::shared_mutex &stripe_of(int key);
+  bool read_buffered(int key, std::span<uint8_t> dest);
+  std::vector<WriteMessageBuffer>
+  buffered_entries(const std::map<int, BufferedWrite> &blocks) const;
+  bool can_send(int target, const std::vector<WriteMessageBuffer> &batch);
+  void send_write(int target, const std::vector<WriteMessageBuffer> &batch);
+  void retire_writes();
+  template <typename Predicate> void wait_for_writes(Predicate done);
+  void await_writes(const std::vector<int> &keys);
+  void flush_write_buffer();
+
   memory_map mem_map;
-  std::map<int, std::pair<int, block>> blocks;
-  std::shared_mutex mtx;
+  BlockSlab slab;
+  std::vector<int> slots;
+  std::vector<uint8_t> valid;
+  std::vector<block_version> versions;
+  std::vector<uint32_t> generations;
+  std::vector<block_version> floors;
+  std::vector<uint8_t> pinned;
+  std::vector<std::atomic<int>> loads;
+  std::array<LockStripe, BLOCK_LOCK_STRIPES> stripes;
+  std::vector<int> owners;
+  std::unique_ptr<EvictionPolicy> policy;
+  int used_slots;
+  std::mutex cache_mtx;
+  std::atomic<uint64_t> cache_hits;
+  std::atomic<uint64_t> cache_misses;
+  std::atomic<uint64_t> cache_evictions;
+  std::vector<std::atomic<bool>> prefetched;
+  std::atomic<uint64_t> cache_prefetches;
+  std::atomic<uint64_t> cache_useful_prefetches;
+  std::atomic<uint64_t> cache_wasted_prefetches;
+  std::map<int, std::shared_ptr<PendingRead>> in_flight;
+  std::mutex in_flight_mtx;
+  std::map<int, InFlightFetch> fetching;
+  std::mutex fetching_mtx;
+  std::map<int, std::map<int, BufferedWrite>> write_buffer;
+  std::map<int, PendingWrite> pending_writes;
+  std::map<int, int> unacked_writes;
+  std::set<int> unacked_keys;
+  std::atomic<int> unacked_count;
+  std::chrono::steady_clock::time_point first_buffered_write;
+  int buffered_writes;
+  std::mutex write_mtx;
+  int next_sequence;
+  int next_request_id;
   int block_size;
   int world_rank;
 };
 
-inline RemoteRepository::RemoteRepository(memory_map mem_map, int block_size,
-                                          int world_rank)
-    : mem_map(mem_map), blocks(std::map<int, std::pair<int, block>>()),
-      block_size(block_size), world_rank(world_rank) {
-  for (int i = 0; i < mem_map.size(); i++) {
-    if (i == world_rank)
-      continue;
+/**
+ * Counts the blocks maintained by every process other than `world_rank`
+ */
+inline int count_remote_blocks(const memory_map &mem_map, int world_rank) {
+  int count = 0;
+  for (size_t i = 0; i < mem_map.size(); i++)
+    if (static_cast<int>(i) != world_rank)
+      count += mem_map[i].size();
 
-    for (int j : mem_map.at(i)) {
-      block b;
-      blocks.emplace(j, std::make_pair(i, b));
-    }
-  }
+  return count;
 }
 
-inline RemoteRepository::~RemoteRepository() = default;
-
 /**
- * Read contents from block indexed by `key`
+ * Resolves how many blocks of `block_size` bytes the remote block cache holds:
+ * as many as fit in `CacheSize` bytes (at least one), or every remote block if
+ * it is unbounded. Any block may become remote once blocks migrate
  */
-inline block RemoteRepository::read(int key) {
-  std::shared_lock lock(mtx);
-  thread_safe_log_with_id(std::format(
-      "READ operation to block {0} called at remote repository level", key));
-  auto handle_error = [&](const int &result, const std::string &type) {
-    if (result != MPI_SUCCESS)
-      throw std::runtime_error(identify_log_string(
-          std::format("{0} failed with code: {1}", type, result), world_rank));
-  };
-
-  auto it = blocks.find(key);
-  if (it == blocks.end())
-    throw std::runtime_error("Bad index");
+inline int get_cache_capacity(const memory_map &mem_map, int block_size,
+                              int world_rank) {
+  int remote_blocks = is_migration_enabled()
+                          ? registry_get(GlobalRegistryIndex::NumBlocks)
+                          : count_remote_blocks(mem_map, world_rank);
+  int cache_size = registry_get(GlobalRegistryIndex::CacheSize);
+  if (cache_size == 0)
+    return remote_blocks;
 
-  std::pair<int, block> &block_pair = blocks.at(it->first);
-  int target = block_pair.first;
-  block &blk = block_pair.second;
+  return std::min(remote_blocks, std::max(cache_size / block_size, 1));
+}
 
-  if (!blk) {
-    thread_safe_log_with_id(
-        std::format("Cached data not available for block {0}. Performing "
-                    "remote access request...",
-                    target));
-    block buffer = std::make_shared<uint8_t[]>(block_size);
+inline RemoteRepository::RemoteRepository(memory_map mem_map, int block_size,
+                                          int world_rank)
+    : mem_map(mem_map),
+      slab(get_cache_capacity(mem_map, block_size, world_rank), block_size),
+      slots(registry_get(GlobalRegistryIndex::NumBlocks), -1),
+      valid(slots.size(), false), versions(slots.size(), BLOCK_VERSION_NONE),
+      generations(slots.size(), 0), floors(slots.size(), BLOCK_VERSION_NONE),
+      pinned(slots.size(), false),
+      loads(registry_get(GlobalRegistryIndex::WorldSize)),
+      owners(slab.capacity(), -1),
+      policy(make_eviction_policy(
+          registry_get(GlobalRegistryIndex::CachePolicy), slab.capacity())),
+      used_slots(0), cache_hits(0), cache_misses(0), cache_evictions(0),
+      prefetched(slots.size()), cache_prefetches(0),
+      cache_useful_prefetches(0), cache_wasted_prefetches(0), unacked_count(0),
+      buffered_writes(0), next_sequence(0), next_request_id(0),
+      block_size(block_size), world_rank(world_rank) {}
 
-    handle_error(MPI_Send(&key, 1, MPI_INT, target,
-                          MESSAGE_TAG_BLOCK_READ_REQUEST, MPI_COMM_WORLD),
-                 "MPI_Send");
+inline RemoteRepository::~RemoteRepository() = default;
 
-    thread_safe_log_with_id(
-        std::format("Sent MPI request for block {0}", target));
+/**
+ * Throws unless `key` indexes a block maintained by another process; blocks
+ * maintained here are let through once migration is enabled, since they may
+ * have migrated here while an operation on them was under way
+ */
+inline void RemoteRepository::check_key(int key) const {
+  if (key < 0 || key >= static_cast<int>(slots.size()) ||
+      (resolve_maintainer(key) == world_rank && !is_migration_enabled()))
+    throw std::runtime_error("Bad index");
+}
 
-    handle_error(MPI_Recv(buffer.get(), block_size, MPI_UNSIGNED_CHAR, target,
-                          MESSAGE_TAG_BLOCK_READ_RESPONSE, MPI_COMM_WORLD,
-                          MPI_STATUS_IGNORE),
-                 "MPI_Recv");
+inline std::shared_mutex &RemoteRepository::stripe_of(int key) {
+  return stripes[key % BLOCK_LOCK_STRIPES].mtx;
+}
 
-    thread_safe_log_with_id(
-        std::format("Received MPI response for block {0} with content {1}",
-                    target, print_block(buffer)));
+/**
+ * Takes a free slab slot for block indexed by `key`, evicting a victim once the
+ * slab is full; returns -1 if every candidate's stripe was busy. Must be called
+ * with the stripe of `key` held exclusively
+ */
+inline int RemoteRepository::allocate_slot(int key) {
+  std::lock_guard lock(cache_mtx);
+  int slot = used_slots < slab.capacity() ? used_slots++ : -1;
 
-    blk = std::make_shared<uint8_t[]>(block_size);
+  if (slot < 0)
+    slot = policy->victim([&](int candidate) {
+      int owner = owners[candidate];
+      std::shared_mutex &stripe = stripe_of(owner);
+      bool held = &stripe == &stripe_of(key);
+      if (!held && !stripe.try_lock())
+        return false;
 
-    thread_safe_log_with_id(
-        std::format("Saved local cache for block {0}", target));
+      thread_safe_log_with_id(std::format(
+          "Evicting block {0} from the local cache for block {1}", owner, key));
+      slots[owner] = -1;
+      valid[owner] = false;
+      versions[owner] = BLOCK_VERSION_NONE;
+      count_wasted_prefetch(owner);
 
-    std::copy_n(buffer.get(), block_size, blk.get());
-  } else {
-    thread_safe_log_with_id(
-        std::format("Using cached data for block {0}, contents: {1}", target,
-                    print_block(blk)));
-  }
+      if (!held)
+        stripe.unlock();
+      return true;
+    });
 
-  block copy = std::make_shared<std::uint8_t[]>(block_size);
-  std::copy_n(blk.get(), block_size, copy.get());
+  if (slot < 0)
+    return -1;
 
-  return copy;
+  if (owners[slot] >= 0)
+    cache_evictions++;
+  owners[slot] = key;
+  slots[key] = slot;
+  policy->insert(slot);
+  return slot;
 }
 
 /**
- * Write `value` to memory block identified by `key`
+ * Copies the contents of a buffered (not yet sent) write to block indexed by
+ * `key` into `dest`; returns `false` unless the whole block was written
  */
-inline void RemoteRepository::write(int key, block value) {
-  std::unique_lock lock(mtx);
-  thread_safe_log_with_id(std::format(
-      "WRITE operation to block {0} called at remote repository level", key));
-  int total_size = get_total_write_message_buffer_size();
-  int target_maintainer = resolve_maintainer(key);
-
-  thread_safe_log_with_id(
-      std::format("Received method call to execute remote WRITE operation to "
-                  "block {0} with value {1} on process ID {2}",
-                  key, print_block(value), target_maintainer));
+inline bool RemoteRepository::read_buffered(int key, std::span<uint8_t> dest) {
+  if (registry_get(GlobalRegistryIndex::WriteMode) != WRITE_BACK)
+    return false;
 
-  WriteMessageBuffer buffer(key, value);
+  std::lock_guard lock(write_mtx);
+  auto target_it = write_buffer.find(resolve_maintainer(key));
+  if (target_it == write_buffer.end())
+    return false;
 
-  std::shared_ptr<uint8_t[]> message_buffer = encode_write_message(buffer);
+  auto it = target_it->second.find(key);
+  if (it == target_it->second.end() || it->second.dirty_bytes < block_size)
+    return false;
 
-  thread_safe_log_with_id(std::format("Sending WRITE request of key: {0}, "
-                                      "value: {1} serialized as {2} over MPI",
-                                      buffer.key, print_block(buffer.data),
-                                      print_block(message_buffer, total_size)));
+  copy_block(block_view(it->second.data.get(), block_size), dest);
+  return true;
+}
 
-  MPI_Send(message_buffer.get(), total_size, MPI_UNSIGNED_CHAR,
-           target_maintainer, MESSAGE_TAG_BLOCK_WRITE_REQUEST, MPI_COMM_WORLD);
+/**
+ * Read contents from block indexed by `key` into `dest`
+ */
+inline void RemoteRepository::read(int key, std::span<uint8_t> dest) {
+  read(std::vector<int>{key}, dest);
 }
 
 /**
- * Export a static representation of the current stored state (for debug and
- * logging purposes)
+ * Read contents from every block indexed by `keys` into consecutive blocks of
+ * `dest`, in order; cached blocks are copied straight from the slab, and all
+ * fetches for the remaining ones are in flight at the same time
  */
-inline std::map<int, block> RemoteRepository::dump() {
-  std::shared_lock lock(mtx);
-  std::map<int, block> copy;
-  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
-  for (const auto &[key, ptr] : blocks) {
-    if (ptr.second == nullptr) {
-      copy[key] = nullptr;
+inline void RemoteRepository::read(const std::vector<int> &keys,
+                                   std::span<uint8_t> dest) {
+  std::vector<int> miss_keys;
+  std::vector<int> miss_indexes;
+
+  await_writes(keys);
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    check_key(keys[i]);
+    if (read_buffered(keys[i], block_subspan(dest, i)))
+      continue;
+
+    std::shared_lock lock(stripe_of(keys[i]));
+    if (valid[keys[i]]) {
+      int slot = slots[keys[i]];
+      copy_block(slab.at(slot), block_subspan(dest, i));
+      policy->touch(slot);
+      cache_hits++;
+      if (prefetched[keys[i]].exchange(false))
+        cache_useful_prefetches++;
     } else {
-      block new_buf = std::make_shared<uint8_t[]>(block_size);
-      std::memcpy(new_buf.get(), ptr.second.get(), block_size);
-      copy[key] = new_buf;
+      miss_keys.push_back(keys[i]);
+      miss_indexes.push_back(i);
     }
   }
 
-  return copy;
+  if (miss_keys.empty())
+    return;
+
+  std::vector<std::future<block>> futures = read_async(miss_keys);
+  for (size_t i = 0; i < futures.size(); i++)
+    copy_block(block_view(futures[i].get().get(), block_size),
+               block_subspan(dest, miss_indexes[i]));
 }
 
-/**
- * Clear locally cached data for block identified by `key`
- */
-inline void RemoteRepository::invalidate_cache(int key) {
-  std::unique_lock lock(mtx);
-  thread_safe_log_with_id(
-      std::format("Erasing local cache for block {0}", key));
-  std::pair<int, block> &block_pair = blocks.at(key);
-  block_pair.second = nullptr;
+inline std::future<block> RemoteRepository::read_async(int key) {
+  return std::move(read_async(std::vector<int>{key}).front());
 }
 
-class UnifiedRepositoryFacade : public IRepository {
-public:
-  UnifiedRepositoryFacade(memory_map mem_map, int block_size, int world_rank);
-  block read(int key) override;
-  void write(int key, block value) override;
-  void invalidate_cache(int key);
-  std::map<int, block> dump() override;
-  virtual ~UnifiedRepositoryFacade() = default;
+inline std::vector<std::future<block>>
+RemoteRepository::read_async(const std::vector<int> &keys) {
+  thread_safe_log_with_id(
+      std::format("READ operation to blocks {0} called at remote repository "
+                  "level",
+                  print_vec(keys)));
+
+  std::vector<std::future<block>> result;
+  std::map<int, std::shared_ptr<PendingRead>> misses;
+
+  await_writes(keys);
+
+  for (int key : keys) {
+    check_key(key);
+    std::promise<block> promise;
+    result.push_back(promise.get_future());
+
+    block buffered = std::make_shared<std::uint8_t[]>(block_size);
+    if (read_buffered(key, std::span<uint8_t>(buffered.get(), block_size))) {
+      promise.set_value(buffered);
+      continue;
+    }
+
+    std::shared_lock lock(stripe_of(key));
+    int slot = slots[key];
+    if (valid[key]) {
+      thread_safe_log_with_id(
+          std::format("Using cached data for block {0}, contents: {1}", key,
+                      print_block(slab.at(slot))));
+      block copy = std::make_shared<std::uint8_t[]>(block_size);
+      copy_block(slab.at(slot), std::span<uint8_t>(copy.get(), block_size));
+      policy->touch(slot);
+      cache_hits++;
+      if (prefetched[key].exchange(false))
+        cache_useful_prefetches++;
+      promise.set_value(copy);
+      continue;
+    }
+
+    cache_misses++;
+    if (join_fetch(key, &promise))
+      continue;
+
+    block stale_copy;
+    if (slot >= 0) {
+      stale_copy = std::make_shared<std::uint8_t[]>(block_size);
+      copy_block(slab.at(slot),
+                 std::span<uint8_t>(stale_copy.get(), block_size));
+    }
+
+    thread_safe_log_with_id(std::format(
+        "Cached data not available for block {0}. Performing remote access "
+        "request...",
+        key));
+
+    int target = route(key);
+    std::shared_ptr<PendingRead> &pending = misses[target];
+    if (!pending) {
+      pending = std::make_shared<PendingRead>();
+      pending->target = target;
+    }
+    pending->keys.push_back(key);
+    pending->versions.push_back(versions[key]);
+    pending->stale_copies.push_back(stale_copy);
+    pending->generations.push_back(generations[key]);
+    pending->promises.push_back(std::move(promise));
+  }
+
+  submit(misses);
+  return result;
+}
+
+/**
+ * Fetches are issued just as for `read_async`, except that blocks are only
+ * saved to the cache; nothing waits for them
+ */
+inline void RemoteRepository::prefetch(const std::vector<int> &keys) {
+  std::set<int> pending_writes_keys;
+  if (unacked_count.load() > 0 ||
+      registry_get(GlobalRegistryIndex::WriteMode) == WRITE_BACK) {
+    std::lock_guard lock(write_mtx);
+    pending_writes_keys = unacked_keys;
+    for (auto &[target, blocks] : write_buffer)
+      for (auto &[key, buffered] : blocks)
+        pending_writes_keys.insert(key);
+  }
+
+  std::map<int, std::shared_ptr<PendingRead>> fetches;
+  for (int key : keys) {
+    check_key(key);
+    if (pending_writes_keys.contains(key))
+      continue;
+
+    std::shared_lock lock(stripe_of(key));
+    if (valid[key] || join_fetch(key, nullptr))
+      continue;
+
+    block stale_copy;
+    if (slots[key] >= 0) {
+      stale_copy = std::make_shared<std::uint8_t[]>(block_size);
+      copy_block(slab.at(slots[key]),
+                 std::span<uint8_t>(stale_copy.get(), block_size));
+    }
+
+    int target = route(key);
+    std::shared_ptr<PendingRead> &pending = fetches[target];
+    if (!pending) {
+      pending = std::make_shared<PendingRead>();
+      pending->target = target;
+      pending->prefetch = true;
+    }
+    pending->keys.push_back(key);
+    pending->versions.push_back(versions[key]);
+    pending->stale_copies.push_back(stale_copy);
+    pending->generations.push_back(generations[key]);
+    pending->promises.emplace_back();
+    cache_prefetches++;
+  }
+
+  if (fetches.empty())
+    return;
+
+  thread_safe_log_with_id(
+      std::format("Prefetching blocks {0}", print_vec(keys)));
+  submit(fetches);
+}
+
+/**
+ * Single-flight check for a miss on block indexed by `key`: if a fetch issued
+ * since its last invalidation is in flight, `promise` (unless null) is queued
+ * to be fulfilled along with it, and `true` is returned; otherwise the caller
+ * is registered as the one fetching it. Must be called with the stripe of `key`
+ * held
+ */
+inline bool RemoteRepository::join_fetch(int key,
+                                         std::promise<block> *promise) {
+  std::lock_guard lock(fetching_mtx);
+  auto [it, created] =
+      fetching.try_emplace(key, InFlightFetch(generations[key], {}));
+
+  if (!created && it->second.generation == generations[key]) {
+    thread_safe_log_with_id(
+        std::format("Waiting for in-flight fetch of block {0}", key));
+    if (promise)
+      it->second.followers.push_back(std::move(*promise));
+    return true;
+  }
+
+  // Followers of a fetch issued before the last invalidation are moved on to
+  // this newer one, which is at least as recent
+  it->second.generation = generations[key];
+  return false;
+}
+
+/**
+ * Fulfill the promises of every follower of the fetch of block indexed by
+ * `key` issued at `generation` with a copy of `data`, which it read
+ */
+inline void RemoteRepository::release_followers(int key, uint32_t generation,
+                                                block data) {
+  std::vector<std::promise<block>> followers;
+  {
+    std::lock_guard lock(fetching_mtx);
+    auto it = fetching.find(key);
+    if (it == fetching.end() || it->second.generation != generation)
+      return;
+
+    followers = std::move(it->second.followers);
+    fetching.erase(it);
+  }
+
+  if (!followers.empty() && prefetched[key].exchange(false))
+    cache_useful_prefetches++;
+
+  for (std::promise<block> &follower : followers) {
+    block copy = std::make_shared<uint8_t[]>(block_size);
+    std::copy_n(data.get(), block_size, copy.get());
+    follower.set_value(copy);
+  }
+}
+
+/**
+ * Resolves the process to fetch block indexed by `key` from: its maintainer
+ * while the block is pinned to it, or else the copy with the fewest keys in
+ * flight from this process (ties are broken by key, so that processes spread
+ * their misses over every copy). Must be called with the stripe of `key` held
+ */
+inline int RemoteRepository::route(int key) {
+  std::vector<int> replicas = resolve_replicas(key);
+  if (pinned[key] || replicas.size() == 1)
+    return replicas.front();
+
+  std::erase(replicas, world_rank);
+  int target = -1;
+  for (size_t i = 0; i < replicas.size(); i++) {
+    int candidate = replicas[(key + world_rank + i) % replicas.size()];
+    if (target < 0 || loads[candidate].load() < loads[target].load())
+      target = candidate;
+  }
+
+  return target;
+}
+
+/**
+ * Register every READ of `reads` in the in-flight table, under a free request
+ * ID, and issue it
+ */
+inline void
+RemoteRepository::submit(std::map<int, std::shared_ptr<PendingRead>> &reads) {
+  std::lock_guard lock(in_flight_mtx);
+  for (auto &[target, pending] : reads)
+    enqueue(pending);
+}
+
+/**
+ * Register `pending` in the in-flight table, under a free request ID, and
+ * issue it; must be called with `in_flight_mtx` held
+ */
+inline void
+RemoteRepository::enqueue(const std::shared_ptr<PendingRead> &pending) {
+  if (in_flight.size() >= READ_REQUEST_ID_SPAN)
+    throw std::runtime_error("Too many READ requests in flight");
+
+  while (in_flight.contains(next_request_id))
+    next_request_id = (next_request_id + 1) % READ_REQUEST_ID_SPAN;
+
+  pending->request_id = next_request_id;
+  in_flight.emplace(pending->request_id, pending);
+  loads[pending->target] += pending->keys.size();
+  issue(*pending);
+}
+
+/**
+ * Post the READ request and the matching response receive for `pending`; the
+ * response is tagged after the request ID, so any number of READs may be in
+ * flight to the same maintainer. It is received from any source, since blocks
+ * that migrated away are answered by the maintainer the request was forwarded
+ * to
+ */
+inline void RemoteRepository::issue(PendingRead &pending) {
+  auto handle_error = [&](const int &result, const std::string &type) {
+    if (result != MPI_SUCCESS)
+      throw std::runtime_error(identify_log_string(
+          std::format("{0} failed with code: {1}", type, result), world_rank));
+  };
+
+  int count = pending.keys.size();
+  int response_size = get_total_read_response_buffer_size(count);
+  pending.request_buffer = encode_read_message(
+      ReadMessageBuffer(pending.request_id, pending.keys, pending.versions));
+  pending.response_buffer = std::make_shared<uint8_t[]>(response_size);
+
+  handle_error(MPI_Irecv(pending.response_buffer.get(), response_size,
+                         MPI_UNSIGNED_CHAR, MPI_ANY_SOURCE,
+                         get_read_response_tag(pending.request_id),
+                         MPI_COMM_WORLD, &pending.requests[0]),
+               "MPI_Irecv");
+
+  handle_error(MPI_Isend(pending.request_buffer.get(),
+                         get_total_read_message_buffer_size(count),
+                         MPI_UNSIGNED_CHAR, pending.target,
+                         MESSAGE_TAG_BLOCK_READ_REQUEST, request_comm(),
+                         &pending.requests[1]),
+               "MPI_Isend");
+
+  thread_safe_log_with_id(std::format(
+      "Sent MPI request for blocks {0} to process of ID {1} (request ID {2})",
+      print_vec(pending.keys), pending.target, pending.request_id));
+}
+
+/**
+ * Save the response for `pending` to the local cache and fulfill its promises;
+ * blocks answered with the version of their stale copy are served from it.
+ * Blocks a replica answered with a version older than their latest known
+ * invalidation are instead moved on to `retries`, to be fetched again from
+ * their maintainer
+ */
+inline void
+RemoteRepository::complete(PendingRead &pending,
+                           std::vector<std::shared_ptr<PendingRead>> &retries) {
+  int request_id;
+
+  std::memcpy(&request_id, pending.response_buffer.get(), sizeof(int));
+  if (request_id != pending.request_id)
+    throw std::runtime_error(identify_log_string(
+        std::format("READ response of request ID {0} does not match request "
+                    "ID {1}",
+                    request_id, pending.request_id),
+        world_rank));
+
+  const uint8_t *cursor = pending.response_buffer.get() + sizeof(int);
+  for (size_t i = 0; i < pending.keys.size(); i++) {
+    int key = pending.keys[i];
+    block data = pending.stale_copies[i];
+    block_version version;
+
+    std::memcpy(&version, cursor, sizeof(block_version));
+    cursor += sizeof(block_version);
+    bool modified = version != pending.versions[i];
+
+    if (modified) {
+      data = std::make_shared<uint8_t[]>(block_size);
+      std::copy_n(cursor, block_size, data.get());
+      cursor += block_size;
+    }
+
+    int maintainer = resolve_maintainer(key);
+    if (is_replication_enabled() && pending.target != maintainer) {
+      std::shared_lock lock(stripe_of(key));
+      if (version < floors[key]) {
+        thread_safe_log_with_id(std::format(
+            "Replica at process of ID {0} answered block {1} at version {2}, "
+            "older than version {3}; fetching it from its maintainer",
+            pending.target, key, version, floors[key]));
+
+        if (retries.empty() || retries.back()->target != maintainer) {
+          retries.push_back(std::make_shared<PendingRead>());
+          retries.back()->target = maintainer;
+          retries.back()->prefetch = pending.prefetch;
+        }
+        PendingRead &retry = *retries.back();
+        retry.keys.push_back(key);
+        retry.versions.push_back(pending.versions[i]);
+        retry.stale_copies.push_back(pending.stale_copies[i]);
+        retry.generations.push_back(pending.generations[i]);
+        retry.promises.push_back(std::move(pending.promises[i]));
+        continue;
+      }
+    } else if (is_replication_enabled()) {
+      std::unique_lock lock(stripe_of(key));
+      if (generations[key] == pending.generations[i])
+        pinned[key] = false;
+    }
+
+    thread_safe_log_with_id(std::format(
+        "Received MPI response for block {0} at version {1} ({2}) with "
+        "content {3}",
+        key, version, modified ? "modified" : "revalidated", print_block(data)));
+
+    fill(key, data, version, pending.generations[i], pending.prefetch);
+    release_followers(key, pending.generations[i], data);
+    pending.promises[i].set_value(data);
+  }
+}
+
+/**
+ * Save `data`, read at `version`, to the cache entry of block indexed by `key`;
+ * copies are never replaced by older versions, and blocks invalidated since
+ * `generation` (while their fetch was in flight) are not marked valid
+ */
+inline void RemoteRepository::fill(int key, block data, block_version version,
+                                   uint32_t generation, bool prefetch) {
+  std::unique_lock lock(stripe_of(key));
+  bool current = generations[key] == generation;
+
+  if (versions[key] != BLOCK_VERSION_NONE && version <= versions[key]) {
+    if (version == versions[key] && current)
+      valid[key] = true;
+    return;
+  }
+
+  int slot = slots[key] >= 0 ? slots[key] : allocate_slot(key);
+  if (slot < 0)
+    return;
+
+  std::copy_n(data.get(), block_size, slab.at(slot).begin());
+  versions[key] = version;
+  valid[key] = current;
+  if (prefetched[key].exchange(prefetch))
+    cache_wasted_prefetches++;
+
+  thread_safe_log_with_id(std::format(
+      "Saved local cache for block {0} at version {1}", key, version));
+}
+
+inline bool RemoteRepository::progress() {
+  std::lock_guard lock(in_flight_mtx);
+  std::vector<std::shared_ptr<PendingRead>> retries;
+
+  for (auto it = in_flight.begin(); it != in_flight.end();) {
+    PendingRead &pending = *it->second;
+    int flag;
+    int test_result =
+        MPI_Testall(2, pending.requests.data(), &flag, MPI_STATUSES_IGNORE);
+
+    if (test_result != MPI_SUCCESS)
+      throw std::runtime_error(identify_log_string(
+          std::format("MPI_Testall failed with code: {0}", test_result),
+          world_rank));
+
+    if (flag) {
+      loads[pending.target] -= pending.keys.size();
+      complete(pending, retries);
+      it = in_flight.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  for (const std::shared_ptr<PendingRead> &retry : retries)
+    enqueue(retry);
+
+  std::lock_guard write_lock(write_mtx);
+  std::chrono::microseconds window(
+      registry_get(GlobalRegistryIndex::WriteBufferWindowMicros));
+  if (buffered_writes > 0 &&
+      std::chrono::steady_clock::now() - first_buffered_write >= window)
+    flush_write_buffer();
+
+  retire_writes();
+
+  return !in_flight.empty() || !pending_writes.empty() || buffered_writes > 0;
+}
+
+/**
+ * Write `value` to memory block identified by `key`
+ */
+inline void RemoteRepository::write(int key, block value) {
+  write({WriteMessageBuffer(key, value, 0, block_size)});
+}
+
+/**
+ * Write every entry of `entries` to the byte range of its memory block; entries
+ * are grouped in a single WRITE request per maintainer, and all requests are
+ * sent concurrently. In write-back mode, entries are only buffered, and writes
+ * to the same block are merged byte-wise.
+ *
+ * Returns once the requests are in flight, without waiting for their
+ * acknowledgements, unless `WriteWindow` requests to the same maintainer (or
+ * one to the same block) are still unacknowledged
+ */
+inline void
+RemoteRepository::write(const std::vector<WriteMessageBuffer> &entries) {
+  if (registry_get(GlobalRegistryIndex::WriteMode) == WRITE_BACK) {
+    std::lock_guard lock(write_mtx);
+    for (const WriteMessageBuffer &entry : entries) {
+      thread_safe_log_with_id(std::format(
+          "WRITE operation to bytes {0} through {1} of block {2} buffered at "
+          "remote repository level",
+          entry.offset, entry.offset + entry.length - 1, entry.key));
+
+      if (!is_valid_write_range(entry))
+        throw std::runtime_error("Bad range");
+
+      BufferedWrite &buffered =
+          write_buffer[resolve_maintainer(entry.key)][entry.key];
+      if (!buffered.data) {
+        if (buffered_writes++ == 0)
+          first_buffered_write = std::chrono::steady_clock::now();
+        buffered.data = std::make_shared<uint8_t[]>(block_size);
+        buffered.dirty.assign(block_size, false);
+        buffered.dirty_bytes = 0;
+      }
+
+      std::copy_n(entry.data.get(), entry.length,
+                  buffered.data.get() + entry.offset);
+      for (int i = entry.offset; i < entry.offset + entry.length; i++) {
+        buffered.dirty_bytes += !buffered.dirty[i];
+        buffered.dirty[i] = true;
+      }
+    }
+
+    if (buffered_writes >= registry_get(GlobalRegistryIndex::WriteBufferSize))
+      flush_write_buffer();
+  } else {
+    std::map<int, std::vector<WriteMessageBuffer>> batches;
+
+    for (const WriteMessageBuffer &entry : entries) {
+      thread_safe_log_with_id(std::format(
+          "WRITE operation to bytes {0} through {1} of block {2} called at "
+          "remote repository level",
+          entry.offset, entry.offset + entry.length - 1, entry.key));
+
+      if (!is_valid_write_range(entry))
+        throw std::runtime_error("Bad range");
+
+      batches[resolve_maintainer(entry.key)].push_back(entry);
+    }
+
+    wait_for_writes([&] {
+      for (auto &[target, batch] : batches)
+        if (!can_send(target, batch))
+          return false;
+
+      for (auto &[target, batch] : batches)
+        send_write(target, batch);
+      return true;
+    });
+  }
+
+  for (const WriteMessageBuffer &entry : entries)
+    invalidate_cache(entry.key);
+}
+
+/**
+ * Whether `batch` may be sent to `target` right away: the window of
+ * unacknowledged requests to `target` has room, and no block of `batch` has an
+ * unacknowledged write (which could otherwise be applied after this one); must
+ * be called with `write_mtx` held
+ */
+inline bool
+RemoteRepository::can_send(int target,
+                           const std::vector<WriteMessageBuffer> &batch) {
+  if (unacked_writes[target] >= registry_get(GlobalRegistryIndex::WriteWindow) ||
+      pending_writes.size() >= WRITE_SEQUENCE_SPAN)
+    return false;
+
+  for (const WriteMessageBuffer &entry : batch)
+    if (unacked_keys.contains(entry.key))
+      return false;
+
+  return true;
+}
+
+/**
+ * Send out a WRITE request carrying `batch` to `target` under the next free
+ * sequence number, posting the receive for its acknowledgement (from any
+ * source, as for READ responses); must be called with `write_mtx` held
+ */
+inline void
+RemoteRepository::send_write(int target,
+                             const std::vector<WriteMessageBuffer> &batch) {
+  auto handle_error = [&](const int &result, const std::string &type) {
+    if (result != MPI_SUCCESS)
+      throw std::runtime_error(identify_log_string(
+          std::format("{0} failed with code: {1}", type, result), world_rank));
+  };
+
+  while (pending_writes.contains(next_sequence))
+    next_sequence = (next_sequence + 1) % WRITE_SEQUENCE_SPAN;
+
+  PendingWrite &pending = pending_writes[next_sequence];
+  pending.target = target;
+  pending.sequence = next_sequence;
+  pending.message_buffer = encode_write_message(pending.sequence, batch);
+  pending.ack_buffer = std::make_shared<uint8_t[]>(sizeof(int));
+
+  for (const WriteMessageBuffer &entry : batch) {
+    pending.keys.push_back(entry.key);
+    unacked_keys.insert(entry.key);
+  }
+  unacked_writes[target]++;
+  unacked_count++;
+
+  int total_size = get_total_write_message_buffer_size(batch);
+  thread_safe_log_with_id(
+      std::format("Sending WRITE request of {0} entries serialized as {1} "
+                  "over MPI to process ID {2} (sequence number {3})",
+                  batch.size(), print_block(pending.message_buffer, total_size),
+                  target, pending.sequence));
+
+  handle_error(MPI_Irecv(pending.ack_buffer.get(), sizeof(int),
+                         MPI_UNSIGNED_CHAR, MPI_ANY_SOURCE,
+                         get_write_ack_tag(pending.sequence), MPI_COMM_WORLD,
+                         &pending.requests[0]),
+               "MPI_Irecv");
+
+  handle_error(MPI_Isend(pending.message_buffer.get(), total_size,
+                         MPI_UNSIGNED_CHAR, target,
+                         MESSAGE_TAG_BLOCK_WRITE_REQUEST, request_comm(),
+                         &pending.requests[1]),
+               "MPI_Isend");
+}
+
+/**
+ * Retire every WRITE request that was both sent and acknowledged; must be
+ * called with `write_mtx` held
+ */
+inline void RemoteRepository::retire_writes() {
+  for (auto it = pending_writes.begin(); it != pending_writes.end();) {
+    PendingWrite &pending = it->second;
+    int flag;
+    int test_result =
+        MPI_Testall(2, pending.requests.data(), &flag, MPI_STATUSES_IGNORE);
+
+    if (test_result != MPI_SUCCESS)
+      throw std::runtime_error(identify_log_string(
+          std::format("MPI_Testall failed with code: {0}", test_result),
+          world_rank));
+
+    if (!flag) {
+      ++it;
+      continue;
+    }
+
+    int sequence;
+    std::memcpy(&sequence, pending.ack_buffer.get(), sizeof(int));
+    if (sequence != pending.sequence)
+      throw std::runtime_error(identify_log_string(
+          std::format("WRITE acknowledgement of sequence number {0} does not "
+                      "match sequence number {1}",
+                      sequence, pending.sequence),
+          world_rank));
+
+    thread_safe_log_with_id(std::format(
+        "WRITE request of sequence number {0} to blocks {1} acknowledged",
+        pending.sequence, print_vec(pending.keys)));
+
+    for (int key : pending.keys)
+      unacked_keys.erase(key);
+    unacked_writes[pending.target]--;
+    unacked_count--;
+    it = pending_writes.erase(it);
+  }
+}
+
+/**
+ * Retires acknowledged WRITE requests until `done` (called with `write_mtx`
+ * held) returns `true`
+ */
+template <typename Predicate>
+inline void RemoteRepository::wait_for_writes(Predicate done) {
+  while (true) {
+    {
+      std::lock_guard lock(write_mtx);
+      retire_writes();
+      if (done())
+        return;
+    }
+
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * Waits until no block of `keys` has an unacknowledged write, so that reads
+ * observe the writes issued before them; partially written blocks still in the
+ * write buffer cannot be served from it, so their maintainer's buffered writes
+ * are sent out first
+ */
+inline void RemoteRepository::await_writes(const std::vector<int> &keys) {
+  if (unacked_count.load() == 0 &&
+      registry_get(GlobalRegistryIndex::WriteMode) != WRITE_BACK)
+    return;
+
+  wait_for_writes([&] {
+    for (int key : keys) {
+      auto target_it = write_buffer.find(resolve_maintainer(key));
+      if (target_it != write_buffer.end()) {
+        auto it = target_it->second.find(key);
+        if (it != target_it->second.end() &&
+            it->second.dirty_bytes < block_size) {
+          std::vector<WriteMessageBuffer> batch =
+              buffered_entries(target_it->second);
+          if (!can_send(target_it->first, batch))
+            return false;
+
+          send_write(target_it->first, batch);
+          buffered_writes -= target_it->second.size();
+          write_buffer.erase(target_it);
+        }
+      }
+
+      if (unacked_keys.contains(key))
+        return false;
+    }
+
+    return true;
+  });
+}
+
+/**
+ * Builds the entries carrying the buffered writes of `blocks`, one per
+ * contiguous run of written bytes; entries alias the buffered data
+ */
+inline std::vector<WriteMessageBuffer> RemoteRepository::buffered_entries(
+    const std::map<int, BufferedWrite> &blocks) const {
+  std::vector<WriteMessageBuffer> entries;
+
+  for (auto &[key, buffered] : blocks) {
+    int start = 0;
+    while (start < block_size) {
+      if (!buffered.dirty[start]) {
+        start++;
+        continue;
+      }
+
+      int end = start;
+      while (end < block_size && buffered.dirty[end])
+        end++;
+
+      entries.push_back(WriteMessageBuffer(
+          key, block(buffered.data, buffered.data.get() + start), start,
+          end - start));
+      start = end;
+    }
+  }
+
+  return entries;
+}
+
+/**
+ * Send out the buffered writes of every maintainer they may be sent to right
+ * away (see `can_send`), keeping the others buffered; must be called with
+ * `write_mtx` held
+ */
+inline void RemoteRepository::flush_write_buffer() {
+  for (auto it = write_buffer.begin(); it != write_buffer.end();) {
+    auto &[target, blocks] = *it;
+    std::vector<WriteMessageBuffer> batch = buffered_entries(blocks);
+
+    if (!can_send(target, batch)) {
+      ++it;
+      continue;
+    }
+
+    send_write(target, batch);
+    buffered_writes -= blocks.size();
+    it = write_buffer.erase(it);
+  }
+}
+
+/**
+ * Send out every buffered write and wait for all outstanding WRITE requests to
+ * be acknowledged; the wait happens outside of `write_mtx`, so the request
+ * dispatcher keeps making progress meanwhile
+ */
+inline void RemoteRepository::fence() {
+  wait_for_writes([&] {
+    flush_write_buffer();
+    return buffered_writes == 0 && pending_writes.empty();
+  });
+}
+
+/**
+ * Export a static representation of the current stored state (for debug and
+ * logging purposes)
+ */
+inline std::map<int, block> RemoteRepository::dump() {
+  std::map<int, block> copy;
+  for (size_t key = 0; key < slots.size(); key++) {
+    if (resolve_maintainer(key) == world_rank)
+      continue;
+
+    std::shared_lock lock(stripe_of(key));
+    if (!valid[key]) {
+      copy[key] = nullptr;
+    } else {
+      block new_buf = std::make_shared<uint8_t[]>(block_size);
+      copy_block(slab.at(slots[key]),
+                 std::span<uint8_t>(new_buf.get(), block_size));
+      copy[key] = new_buf;
+    }
+  }
+
+  return copy;
+}
+
+/**
+ * Mark locally cached data for block identified by `key` as stale; its
+ * contents are kept for revalidation, and bumping its generation keeps fetches
+ * already in flight from marking it valid again. The block is pinned to its
+ * maintainer, since its replicas may not have seen the write behind this yet
+ */
+inline void RemoteRepository::invalidate_cache(int key) {
+  check_key(key);
+  std::unique_lock lock(stripe_of(key));
+  thread_safe_log_with_id(
+      std::format("Erasing local cache for block {0}", key));
+  valid[key] = false;
+  pinned[key] = true;
+  generations[key]++;
+  count_wasted_prefetch(key);
+}
+
+inline void RemoteRepository::invalidate_cache(int key, block_version version) {
+  check_key(key);
+  std::unique_lock lock(stripe_of(key));
+  floors[key] = std::max(floors[key], version);
+  if (versions[key] != BLOCK_VERSION_NONE && versions[key] >= version) {
+    thread_safe_log_with_id(std::format(
+        "Ignoring stale invalidation of block {0} at version {1} (cached at "
+        "version {2})",
+        key, version, versions[key]));
+    return;
+  }
+
+  thread_safe_log_with_id(std::format(
+      "Erasing local cache for block {0} (written at version {1})", key,
+      version));
+  valid[key] = false;
+  generations[key]++;
+  count_wasted_prefetch(key);
+}
+
+/**
+ * Counts block indexed by `key` as a wasted prefetch if it was prefetched and
+ * not read since; must be called with its stripe held exclusively
+ */
+inline void RemoteRepository::count_wasted_prefetch(int key) {
+  if (prefetched[key].exchange(false))
+    cache_wasted_prefetches++;
+}
+
+inline CacheStats RemoteRepository::cache_stats() {
+  return CacheStats(cache_hits.load(), cache_misses.load(),
+                    cache_evictions.load(), cache_prefetches.load(),
+                    cache_useful_prefetches.load(),
+                    cache_wasted_prefetches.load());
+}
+
+/**
+ * One-sided alternative to the message-based backend: the blocks maintained by
+ * each process live in a slab exposed through an `MPI_Win` over
+ * `worker_comm`, and every block (local or remote) is accessed with
+ * `MPI_Get`/`MPI_Put` inside a passive-target epoch held for the lifetime of
+ * the repository, so remote accesses take no CPU work from their maintainer.
+ * Blocks are never cached, hence never invalidated
+ */
+class RmaRepository : public IRemoteRepository {
+public:
+  RmaRepository(memory_map mem_map, int block_size, int world_rank);
+  void read(int key, std::span<uint8_t> dest) override;
+  void read(const std::vector<int> &keys, std::span<uint8_t> dest) override;
+  void write(int key, block value) override;
+  void write(const std::vector<WriteMessageBuffer> &entries) override;
+  std::map<int, block> dump() override;
+  void invalidate_cache(int key) override;
+  void invalidate_cache(int key, block_version version) override;
+  CacheStats cache_stats() override;
+  std::future<block> read_async(int key) override;
+  std::vector<std::future<block>>
+  read_async(const std::vector<int> &keys) override;
+  void prefetch(const std::vector<int> &keys) override;
+  bool progress() override;
+  void fence() override;
+  ~RmaRepository();
+
+private:
+  /**
+   * Outstanding `MPI_Rget` for block indexed by `key`, along with the `promise`
+   * to fulfill once its contents arrive at `data`
+   */
+  struct PendingGet {
+    int key;
+    block data;
+    std::promise<block> promise;
+    MPI_Request request;
+  };
+
+  MPI_Request get(int key, std::span<uint8_t> dest);
+  MPI_Aint displacement_of(int key, int offset) const;
+  void handle_error(int result, const std::string &type) const;
+
+  memory_map mem_map;
+  BlockSlab slab;
+  std::vector<int> displacements;
+  std::deque<PendingGet> in_flight;
+  std::mutex in_flight_mtx;
+  MPI_Win win;
+  int block_size;
+  int world_rank;
+};
+
+inline RmaRepository::RmaRepository(memory_map mem_map, int block_size,
+                                    int world_rank)
+    : mem_map(mem_map), slab(mem_map.at(world_rank).size(), block_size),
+      displacements(registry_get(GlobalRegistryIndex::NumBlocks), -1),
+      block_size(block_size), world_rank(world_rank) {
+  for (const std::vector<int> &keys : mem_map)
+    for (size_t i = 0; i < keys.size(); i++)
+      displacements.at(keys[i]) = i;
+
+  handle_error(MPI_Win_create(slab.data(), slab.size_bytes(), 1,
+                              MPI_INFO_NULL, worker_comm(), &win),
+               "MPI_Win_create");
+  handle_error(MPI_Win_lock_all(MPI_MODE_NOCHECK, win), "MPI_Win_lock_all");
+}
+
+/**
+ * Closes the access epoch and frees the window; collective over `worker_comm`
+ */
+inline RmaRepository::~RmaRepository() {
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (finalized)
+    return;
+
+  MPI_Win_unlock_all(win);
+  MPI_Win_free(&win);
+}
+
+inline void RmaRepository::handle_error(int result,
+                                        const std::string &type) const {
+  if (result != MPI_SUCCESS)
+    throw std::runtime_error(identify_log_string(
+        std::format("{0} failed with code: {1}", type, result), world_rank));
+}
+
+/**
+ * Resolves the window displacement (in bytes) of byte `offset` of block indexed
+ * by `key`, within the slab of its maintainer
+ */
+inline MPI_Aint RmaRepository::displacement_of(int key, int offset) const {
+  if (key < 0 || key >= static_cast<int>(displacements.size()) ||
+      displacements[key] < 0)
+    throw std::runtime_error("Bad index");
+
+  return static_cast<MPI_Aint>(displacements[key]) * block_size + offset;
+}
+
+/**
+ * Start fetching block indexed by `key` into `dest`; only `dest.size()` bytes
+ * of the block are transferred
+ */
+inline MPI_Request RmaRepository::get(int key, std::span<uint8_t> dest) {
+  MPI_Request request;
+  handle_error(MPI_Rget(dest.data(), dest.size(), MPI_UNSIGNED_CHAR,
+                        resolve_maintainer(key), displacement_of(key, 0),
+                        dest.size(), MPI_UNSIGNED_CHAR, win, &request),
+               "MPI_Rget");
+
+  return request;
+}
+
+/**
+ * Read contents from block indexed by `key` into `dest`
+ */
+inline void RmaRepository::read(int key, std::span<uint8_t> dest) {
+  read(std::vector<int>{key}, dest);
+}
+
+/**
+ * Read contents from every block indexed by `keys` into consecutive blocks of
+ * `dest`, in order; all gets are in flight at the same time
+ */
+inline void RmaRepository::read(const std::vector<int> &keys,
+                                std::span<uint8_t> dest) {
+  thread_safe_log_with_id(std::format(
+      "READ operation to blocks {0} called at RMA repository level",
+      print_vec(keys)));
+
+  std::vector<MPI_Request> requests;
+  for (size_t i = 0; i < keys.size(); i++) {
+    std::span<uint8_t> block_dest = block_subspan(dest, i);
+    if (!block_dest.empty())
+      requests.push_back(get(keys[i], block_dest));
+  }
+
+  handle_error(
+      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE),
+      "MPI_Waitall");
+}
+
+inline std::future<block> RmaRepository::read_async(int key) {
+  return std::move(read_async(std::vector<int>{key}).front());
+}
+
+inline std::vector<std::future<block>>
+RmaRepository::read_async(const std::vector<int> &keys) {
+  std::lock_guard lock(in_flight_mtx);
+  std::vector<std::future<block>> result;
+
+  for (int key : keys) {
+    PendingGet &pending = in_flight.emplace_back();
+    pending.key = key;
+    pending.data = std::make_shared<uint8_t[]>(block_size);
+    pending.request =
+        get(key, std::span<uint8_t>(pending.data.get(), block_size));
+    result.push_back(pending.promise.get_future());
+  }
+
+  return result;
+}
+
+inline bool RmaRepository::progress() {
+  std::lock_guard lock(in_flight_mtx);
+
+  for (auto it = in_flight.begin(); it != in_flight.end();) {
+    int flag;
+    handle_error(MPI_Test(&it->request, &flag, MPI_STATUS_IGNORE), "MPI_Test");
+
+    if (flag) {
+      thread_safe_log_with_id(
+          std::format("Received RMA contents for block {0}: {1}", it->key,
+                      print_block(it->data)));
+      it->promise.set_value(it->data);
+      it = in_flight.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return !in_flight.empty();
+}
+
+/**
+ * Write `value` to memory block identified by `key`
+ */
+inline void RmaRepository::write(int key, block value) {
+  write({WriteMessageBuffer(key, value, 0, block_size)});
+}
+
+/**
+ * Write every entry of `entries` to the byte range of its memory block; all
+ * puts are issued before the maintainers are flushed, once each
+ */
+inline void
+RmaRepository::write(const std::vector<WriteMessageBuffer> &entries) {
+  std::set<int> targets;
+
+  for (const WriteMessageBuffer &entry : entries) {
+    thread_safe_log_with_id(std::format(
+        "WRITE operation to block {0} called at RMA repository level",
+        entry.key));
+
+    if (!is_valid_write_range(entry))
+      throw std::runtime_error("Bad range");
+
+    int target = resolve_maintainer(entry.key);
+    handle_error(MPI_Put(entry.data.get(), entry.length, MPI_UNSIGNED_CHAR,
+                         target, displacement_of(entry.key, entry.offset),
+                         entry.length, MPI_UNSIGNED_CHAR, win),
+                 "MPI_Put");
+    targets.insert(target);
+  }
+
+  for (int target : targets)
+    handle_error(MPI_Win_flush(target, win), "MPI_Win_flush");
+}
+
+/**
+ * Export a static representation of the current stored state (for debug and
+ * logging purposes); blocks maintained by other processes are not cached, so
+ * they are reported as empty
+ */
+inline std::map<int, block> RmaRepository::dump() {
+  std::map<int, block> copy;
+  for (size_t key = 0; key < displacements.size(); key++)
+    copy[key] = nullptr;
+
+  const std::vector<int> &local_keys = mem_map.at(world_rank);
+  std::shared_ptr<uint8_t[]> contents =
+      std::make_shared<uint8_t[]>(local_keys.size() * block_size);
+  read(local_keys,
+       std::span<uint8_t>(contents.get(), local_keys.size() * block_size));
+
+  for (size_t i = 0; i < local_keys.size(); i++) {
+    block new_buf = std::make_shared<uint8_t[]>(block_size);
+    std::copy_n(contents.get() + i * block_size, block_size, new_buf.get());
+    copy[local_keys[i]] = new_buf;
+  }
+
+  return copy;
+}
+
+/**
+ * No-op; blocks are never cached by this backend
+ */
+inline void RmaRepository::invalidate_cache(int) {}
+
+/**
+ * No-op; blocks are never cached by this backend
+ */
+inline void RmaRepository::invalidate_cache(int, block_version) {}
+
+/**
+ * Blocks are never cached by this backend, so every counter stays at zero
+ */
+inline CacheStats RmaRepository::cache_stats() {
+  return CacheStats(0, 0, 0, 0, 0, 0);
+}
+
+/**
+ * No-op; blocks are never cached by this backend
+ */
+inline void RmaRepository::prefetch(const std::vector<int> &) {}
+
+/**
+ * No-op; every write is flushed to its maintainer before returning
+ */
+inline void RmaRepository::fence() {}
+
+/**
+ * Transfers the blocks indexed by `keys` (sorted) between consecutive blocks
+ * of `contents` and the image at `path` (block `k` stored at byte
+ * `k * block_size`), writing them if `writing` is set (creating the image, or
+ * resizing it to hold every block) or reading them otherwise (throwing unless
+ * the image holds every block). Collective over `worker_comm`: every worker
+ * transfers its own blocks in a single call, through a file view exposing
+ * them alone
+ */
+inline void transfer_image(const std::string &path,
+                           const std::vector<int> &keys,
+                           std::span<uint8_t> contents, bool writing) {
+  int num_blocks = registry_get(GlobalRegistryIndex::NumBlocks);
+  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  MPI_Offset image_size = static_cast<MPI_Offset>(num_blocks) * block_size;
+
+  auto handle_error = [&](int result, const std::string &type) {
+    if (result != MPI_SUCCESS)
+      throw std::runtime_error(std::format(
+          "{0} failed on image {1} with code: {2}", type, path, result));
+  };
+
+  MPI_File file;
+  handle_error(MPI_File_open(worker_comm(), path.c_str(),
+                             writing ? MPI_MODE_CREATE | MPI_MODE_WRONLY
+                                     : MPI_MODE_RDONLY,
+                             MPI_INFO_NULL, &file),
+               "MPI_File_open");
+
+  // The calls below are collective, so a call failing on a single worker must
+  // stop every worker before the next one, lest the others wait on it forever:
+  // the file is closed (and `cleanup` run) on every worker, which then throws
+  auto agree = [&](int result, const std::string &type, auto cleanup) {
+    int failed = result != MPI_SUCCESS;
+    MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_LOR, worker_comm());
+    if (!failed)
+      return;
+    cleanup();
+    MPI_File_close(&file);
+    handle_error(result, type);
+    throw std::runtime_error(std::format(
+        "{0} failed on image {1} at another worker", type, path));
+  };
+
+  MPI_Offset size;
+  agree(MPI_File_get_size(file, &size), "MPI_File_get_size", [] {});
+  if (!writing && size != image_size) {
+    MPI_File_close(&file);
+    throw std::runtime_error(std::format(
+        "Image {0} holds {1} bytes, but {2} blocks of {3} bytes were expected",
+        path, size, num_blocks, block_size));
+  }
+
+  MPI_Datatype block_type, view_type;
+  MPI_Type_contiguous(block_size, MPI_BYTE, &block_type);
+  MPI_Type_create_indexed_block(keys.size(), 1, keys.data(), block_type,
+                                &view_type);
+  MPI_Type_commit(&block_type);
+  MPI_Type_commit(&view_type);
+  auto free_types = [&] {
+    MPI_Type_free(&view_type);
+    MPI_Type_free(&block_type);
+  };
+
+  agree(MPI_File_set_view(file, 0, block_type, view_type, "native",
+                          MPI_INFO_NULL),
+        "MPI_File_set_view", free_types);
+  if (writing)
+    agree(MPI_File_set_size(file, image_size), "MPI_File_set_size",
+          free_types);
+
+  int result = writing ? MPI_File_write_at_all(file, 0, contents.data(),
+                                               keys.size(), block_type,
+                                               MPI_STATUS_IGNORE)
+                       : MPI_File_read_at_all(file, 0, contents.data(),
+                                              keys.size(), block_type,
+                                              MPI_STATUS_IGNORE);
+
+  free_types();
+  MPI_File_close(&file);
+  handle_error(result, writing ? "Image write" : "Image read");
+}
+
+/**
+ * Single entry point to every block, routing each operation to the local or
+ * the remote repository, depending on which process currently maintains the
+ * block.
+ *
+ * When migration is enabled, accesses to local blocks are counted by the
+ * process they were made on behalf of (see `MigrationTracker`), and blocks
+ * dominated by another process are handed over to it: the block is released
+ * locally and sent over in a MIGRATION message, and its new maintainer is
+ * announced to every other worker with an OWNERSHIP message, which also
+ * invalidates their cached copies. Local operations hold the guard of every
+ * block they touch (shared), which its migration takes exclusively, so that
+ * blocks never migrate away in the middle of one; requests that still reach a
+ * former maintainer are forwarded (see `read_forwarded` and `write_forwarded`)
+ */
+class UnifiedRepositoryFacade : public IRepository {
+public:
+  UnifiedRepositoryFacade(memory_map mem_map, int block_size, int world_rank);
+  void read(int key, std::span<uint8_t> dest) override;
+  void read(const std::vector<int> &keys, std::span<uint8_t> dest) override;
+  void write(int key, block value) override;
+  void write(const std::vector<WriteMessageBuffer> &entries) override;
+  void invalidate_cache(int key);
+
+  /**
+   * Clear locally cached data for every block of `batch` maintained by another
+   * process, unless the cached copy is at least as recent as the version it
+   * was written at
+   */
+  void invalidate_cache(const NotificationBatch &batch);
+
+  /**
+   * Read every block of `message` maintained (or replicated) by this process,
+   * and not read yet, into it, on behalf of its origin (recorded as a sharer
+   * of the blocks under directory-based coherence)
+   */
+  void read_forwarded(ForwardedReadMessageBuffer &message);
+
+  /**
+   * Write every entry of `entries` whose block is maintained by this process,
+   * on behalf of process `origin`; returns the entries left for other
+   * maintainers
+   */
+  std::vector<WriteMessageBuffer>
+  write_forwarded(int origin, const std::vector<WriteMessageBuffer> &entries);
+
+  /**
+   * Apply every block of `batch`, pushed by its maintainer, to the read
+   * replica held here
+   */
+  void replicate(const ReplicaUpdateBatch &batch);
+
+  /**
+   * Start maintaining the block handed over by MIGRATION `message`
+   */
+  void adopt(const MigrationMessageBuffer &message);
+
+  /**
+   * Record the maintainer announced by OWNERSHIP `message`, unless a later
+   * migration of the block is already known
+   */
+  void relocate(const OwnershipMessageBuffer &message);
+  std::map<int, block> dump() override;
+
+  /**
+   * Start reading block indexed by `key`, without waiting for its contents
+   */
+  std::future<block> read_async(int key);
+
+  /**
+   * Counters of the local cache of remote blocks
+   */
+  CacheStats cache_stats();
+
+  /**
+   * Advance outstanding remote operations; returns `true` while any are
+   * pending
+   */
+  bool progress();
+
+  /**
+   * Send out every buffered remote write (write-back mode only)
+   */
+  void fence();
+
+  /**
+   * Coordinated checkpoint, to be called by every worker at once: outstanding
+   * writes are flushed and acknowledged, and once every worker got there, each
+   * persists the blocks it holds; returns once all of them are done
+   */
+  void checkpoint();
+
+  /**
+   * Complete the restore of the blocks persisted by the last checkpoint (read
+   * back on construction), once helper threads are running: read replicas,
+   * which may have been persisted ahead of some pushes, are brought up to date
+   */
+  void restore();
+
+  /**
+   * Overwrite every block with the image at `path` (block `k` stored at byte
+   * `k * block_size`), to be called by every worker at once: each reads the
+   * blocks it maintains, in a single collective MPI-IO read, and cached copies
+   * are invalidated everywhere once all of them are done; no other operation
+   * may be under way meanwhile
+   */
+  void load(const std::string &path);
+
+  /**
+   * Write every block out to an image at `path` (see `load`), to be called by
+   * every worker at once: outstanding writes are flushed and acknowledged, and
+   * each worker then writes the blocks it maintains, in a single collective
+   * MPI-IO write; the image replaces any previous one at once
+   */
+  void dump(const std::string &path);
+  virtual ~UnifiedRepositoryFacade() = default;
 
 private:
-  std::map<int, std::shared_ptr<IRepository>> access_map;
+  /**
+   * Ownership state of every block, kept behind a pointer so that the facade
+   * stays movable: `stripes` guard which process maintains every block `k`
+   * such that `k % BLOCK_LOCK_STRIPES` matches their index, `epochs` count the
+   * migrations of every block known here, and `adopted` flags the blocks that
+   * migrated here while remote writes to them may still be in flight
+   */
+  struct Ownership {
+    Ownership(int num_blocks);
+
+    std::array<std::shared_mutex, BLOCK_LOCK_STRIPES> stripes;
+    std::mutex mtx;
+    std::vector<int> epochs;
+    std::vector<std::atomic<bool>> adopted;
+  };
+
+  bool is_local(int key) const;
+  std::vector<std::shared_lock<std::shared_mutex>>
+  guard(const std::vector<int> &keys);
+  void settle(const std::vector<int> &keys);
+  template <typename Operation>
+  std::vector<size_t> with_local(const std::vector<int> &keys, int requester,
+                                 Operation op);
+  void migrate(const std::map<int, int> &migrations);
+  std::vector<int> maintained_keys();
+
   memory_map mem_map;
-  std::shared_ptr<IRepository> local;
-  std::shared_ptr<IRepository> remote;
+  std::shared_ptr<LocalRepository> local;
+  std::shared_ptr<IRemoteRepository> remote;
+  std::shared_ptr<SequentialPrefetcher> prefetcher;
+  std::shared_ptr<Ownership> ownership;
+  std::shared_ptr<MigrationTracker> tracker;
+  int block_size;
+  int world_rank;
 };
 
+inline UnifiedRepositoryFacade::Ownership::Ownership(int num_blocks)
+    : epochs(num_blocks, 0), adopted(num_blocks) {}
+
 inline UnifiedRepositoryFacade::UnifiedRepositoryFacade(memory_map mem_map,
                                                         int block_size,
                                                         int world_rank)
-    : access_map(std::map<int, std::shared_ptr<IRepository>>()),
-      mem_map(mem_map) {
+    : mem_map(mem_map),
+      ownership(std::make_shared<Ownership>(
+          registry_get(GlobalRegistryIndex::NumBlocks))),
+      block_size(block_size), world_rank(world_rank) {
+  int num_blocks = registry_get(GlobalRegistryIndex::NumBlocks);
+
+  if (registry_get(GlobalRegistryIndex::Backend) == BACKEND_RMA) {
+    remote = std::make_shared<RmaRepository>(mem_map, block_size, world_rank);
+    prefetcher = std::make_shared<SequentialPrefetcher>(0, num_blocks);
+    return;
+  }
+
   local = std::make_shared<LocalRepository>(mem_map, block_size, world_rank);
   remote = std::make_shared<RemoteRepository>(mem_map, block_size, world_rank);
+  prefetcher = std::make_shared<SequentialPrefetcher>(
+      registry_get(GlobalRegistryIndex::PrefetchDepth), num_blocks);
+
+  if (is_migration_enabled())
+    tracker = std::make_shared<MigrationTracker>(
+        registry_get(GlobalRegistryIndex::MigrationThreshold), world_rank);
+};
+
+/**
+ * Whether block indexed by `key` is currently maintained by this process
+ */
+inline bool UnifiedRepositoryFacade::is_local(int key) const {
+  return local && resolve_maintainer(key) == world_rank;
+}
+
+/**
+ * Takes the ownership guard of every block of `keys` (shared), in stripe
+ * order, so that concurrent callers never deadlock; no guards are needed
+ * unless migration is enabled
+ */
+inline std::vector<std::shared_lock<std::shared_mutex>>
+UnifiedRepositoryFacade::guard(const std::vector<int> &keys) {
+  std::vector<std::shared_lock<std::shared_mutex>> guards;
+  if (!tracker)
+    return guards;
+
+  std::set<int> indexes;
+  for (int key : keys)
+    indexes.insert(key % BLOCK_LOCK_STRIPES);
+
+  for (int index : indexes)
+    guards.emplace_back(ownership->stripes[index]);
+  return guards;
+}
+
+/**
+ * Waits for every remote write issued by this process before any block of
+ * `keys` migrated here, so that local operations on it are applied after them.
+ * Only called for operations of this process: forwarded operations may be
+ * the very writes being waited for
+ */
+inline void UnifiedRepositoryFacade::settle(const std::vector<int> &keys) {
+  if (!tracker)
+    return;
+
+  std::vector<int> adopted;
+  for (int key : keys)
+    if (ownership->adopted[key].load())
+      adopted.push_back(key);
+
+  if (adopted.empty())
+    return;
+
+  remote->fence();
+  for (int key : adopted)
+    ownership->adopted[key] = false;
+}
 
-  for (int i = 0; i < mem_map.size(); i++) {
-    for (auto j : mem_map.at(i)) {
-      access_map.emplace(j, i == world_rank ? local : remote);
+/**
+ * Runs `op` with the indexes (in `keys`) of the blocks maintained by this
+ * process, which cannot migrate away while it runs, counting an access to
+ * each of them on behalf of process `requester` and migrating those that
+ * should be; returns the indexes of the other blocks, for which nothing was
+ * done
+ */
+template <typename Operation>
+inline std::vector<size_t>
+UnifiedRepositoryFacade::with_local(const std::vector<int> &keys,
+                                    int requester, Operation op) {
+  std::vector<size_t> local_indexes, remote_indexes;
+  std::map<int, int> migrations;
+
+  {
+    std::vector<std::shared_lock<std::shared_mutex>> guards = guard(keys);
+    for (size_t i = 0; i < keys.size(); i++)
+      (is_local(keys[i]) ? local_indexes : remote_indexes).push_back(i);
+
+    if (!local_indexes.empty())
+      op(local_indexes);
+
+    if (tracker)
+      for (size_t i : local_indexes) {
+        int target = tracker->record(keys[i], requester);
+        if (target >= 0)
+          migrations[keys[i]] = target;
+      }
+  }
+
+  migrate(migrations);
+  return remote_indexes;
+}
+
+/**
+ * Hand every block of `migrations` over to the process it maps to; blocks that
+ * already migrated away (through a concurrent call) are skipped. The MIGRATION
+ * message is sent before the maintainer is updated, so that any request this
+ * process forwards to the new maintainer reaches it after the block. Any copy
+ * of the block cached here is dropped along with it: one may have been filled
+ * by a read forwarded back while the block was being adopted, and the new
+ * maintainer never records this process as its sharer
+ */
+inline void
+UnifiedRepositoryFacade::migrate(const std::map<int, int> &migrations) {
+  auto handle_error = [&](const int &result) {
+    if (result != MPI_SUCCESS)
+      throw std::runtime_error("Encountered unexpected exception at `facade` "
+                               "level while attempting to migrate a block");
+  };
+
+  for (auto &[key, target] : migrations) {
+    int epoch;
+    {
+      std::unique_lock guard(ownership->stripes[key % BLOCK_LOCK_STRIPES]);
+      if (!is_local(key))
+        continue;
+
+      auto [version, data] = local->release(key);
+      remote->invalidate_cache(key);
+      {
+        std::lock_guard lock(ownership->mtx);
+        epoch = ++ownership->epochs[key];
+      }
+
+      thread_safe_log_with_id(
+          std::format("Migrating block {0} at version {1} to process of ID {2}",
+                      key, version, target));
+
+      MigrationMessageBuffer message(key, epoch, version, data);
+      handle_error(MPI_Send(encode_migration_message(message).get(),
+                            get_total_migration_message_buffer_size(),
+                            MPI_UNSIGNED_CHAR, target,
+                            MESSAGE_TAG_BLOCK_MIGRATION, request_comm()));
+      set_maintainer(key, target);
     }
+
+    tracker->forget(key);
+
+    std::shared_ptr<uint8_t[]> announcement =
+        encode_ownership_message(OwnershipMessageBuffer(key, epoch, target));
+    int num_workers =
+        get_num_worker_procs(registry_get(GlobalRegistryIndex::WorldSize));
+
+    for (int rank = 0; rank < num_workers; rank++)
+      if (rank != world_rank && rank != target)
+        handle_error(MPI_Send(announcement.get(),
+                              get_total_ownership_message_buffer_size(),
+                              MPI_UNSIGNED_CHAR, rank,
+                              MESSAGE_TAG_BLOCK_OWNERSHIP, request_comm()));
   }
-};
+}
 
 /**
  * Write `value` to memory block identified by `key`
  */
 inline void UnifiedRepositoryFacade::write(int key, block value) {
-  access_map.at(key)->write(key, value);
+  write({WriteMessageBuffer(key, value, 0, block_size)});
+}
+
+/**
+ * Write every entry of `entries` to its memory block; local and remote entries
+ * are each forwarded to their repository in a single call
+ */
+inline void
+UnifiedRepositoryFacade::write(const std::vector<WriteMessageBuffer> &entries) {
+  std::vector<int> keys;
+  for (const WriteMessageBuffer &entry : entries)
+    keys.push_back(entry.key);
+
+  settle(keys);
+  std::vector<size_t> remote_indexes =
+      with_local(keys, world_rank, [&](const std::vector<size_t> &indexes) {
+        std::vector<WriteMessageBuffer> local_entries;
+        for (size_t i : indexes)
+          local_entries.push_back(entries[i]);
+        local->write(local_entries);
+      });
+
+  std::vector<WriteMessageBuffer> remote_entries;
+  for (size_t i : remote_indexes)
+    remote_entries.push_back(entries[i]);
+
+  if (!remote_entries.empty())
+    remote->write(remote_entries);
+}
+
+/**
+ * Read contents from block indexed by `key` into `dest`
+ */
+inline void UnifiedRepositoryFacade::read(int key, std::span<uint8_t> dest) {
+  settle({key});
+  if (!with_local({key}, world_rank, [&](const std::vector<size_t> &) {
+         local->read(key, dest);
+       }).empty())
+    remote->read(key, dest);
+}
+
+inline std::future<block> UnifiedRepositoryFacade::read_async(int key) {
+  block data = std::make_shared<uint8_t[]>(block_size);
+
+  settle({key});
+  if (!with_local({key}, world_rank, [&](const std::vector<size_t> &) {
+         local->read(key, std::span<uint8_t>(data.get(), block_size));
+       }).empty())
+    return remote->read_async(key);
+
+  std::promise<block> promise;
+  promise.set_value(data);
+  return promise.get_future();
+}
+
+inline bool UnifiedRepositoryFacade::progress() { return remote->progress(); }
+
+inline CacheStats UnifiedRepositoryFacade::cache_stats() {
+  return remote->cache_stats();
+}
+
+inline void UnifiedRepositoryFacade::fence() { remote->fence(); }
+
+inline void UnifiedRepositoryFacade::checkpoint() {
+  remote->fence();
+  MPI_Barrier(worker_comm());
+
+  if (local)
+    local->checkpoint();
+
+  MPI_Barrier(worker_comm());
+}
+
+inline void UnifiedRepositoryFacade::restore() {
+  if (local)
+    local->resync_replicas();
+}
+
+/**
+ * Blocks handed over to this process may still be on their way, so the keys
+ * are resolved again until every block is claimed by some worker (collective
+ * over `worker_comm`); blocks must not migrate away meanwhile
+ */
+inline std::vector<int> UnifiedRepositoryFacade::maintained_keys() {
+  int num_blocks = registry_get(GlobalRegistryIndex::NumBlocks);
+
+  while (true) {
+    std::vector<int> keys;
+    for (int key = 0; key < num_blocks; key++)
+      if (resolve_maintainer(key) == world_rank)
+        keys.push_back(key);
+
+    if (!tracker)
+      return keys;
+
+    int count = keys.size(), total = 0;
+    MPI_Allreduce(&count, &total, 1, MPI_INT, MPI_SUM, worker_comm());
+    if (total == num_blocks)
+      return keys;
+
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * Every block is written through its repository without notifying anyone (or
+ * with RMA puts to this process' own window), so caches are invalidated here
+ * instead, once every worker is done; block versions keep growing, so copies
+ * cached before the load are never revalidated
+ */
+inline void UnifiedRepositoryFacade::load(const std::string &path) {
+  int num_blocks = registry_get(GlobalRegistryIndex::NumBlocks);
+  std::vector<int> all_keys(num_blocks);
+  std::iota(all_keys.begin(), all_keys.end(), 0);
+
+  remote->fence();
+  MPI_Barrier(worker_comm());
+
+  {
+    std::vector<std::shared_lock<std::shared_mutex>> guards = guard(all_keys);
+    std::vector<int> keys = maintained_keys();
+    size_t count = keys.size();
+    std::shared_ptr<uint8_t[]> contents =
+        std::make_shared<uint8_t[]>(count * block_size);
+
+    transfer_image(path, keys,
+                   std::span<uint8_t>(contents.get(), count * block_size),
+                   false);
+
+    if (local) {
+      local->load(keys, block_view(contents.get(), count * block_size));
+    } else {
+      std::vector<WriteMessageBuffer> entries;
+      for (size_t i = 0; i < count; i++)
+        entries.push_back(WriteMessageBuffer(
+            keys[i], block(contents, contents.get() + i * block_size), 0,
+            block_size));
+      remote->write(entries);
+    }
+
+    thread_safe_log_with_id(
+        std::format("Loaded {0} blocks from image {1}", count, path));
+  }
+
+  MPI_Barrier(worker_comm());
+  for (int key = 0; key < num_blocks; key++)
+    if (!is_local(key))
+      remote->invalidate_cache(key);
+}
+
+/**
+ * The image is written to a temporary file first, which the master worker
+ * renames once every worker is done
+ */
+inline void UnifiedRepositoryFacade::dump(const std::string &path) {
+  int num_blocks = registry_get(GlobalRegistryIndex::NumBlocks);
+  std::vector<int> all_keys(num_blocks);
+  std::iota(all_keys.begin(), all_keys.end(), 0);
+  std::string temporary = path + ".tmp";
+
+  remote->fence();
+  MPI_Barrier(worker_comm());
+
+  {
+    std::vector<std::shared_lock<std::shared_mutex>> guards = guard(all_keys);
+    std::vector<int> keys = maintained_keys();
+    size_t count = keys.size();
+    std::shared_ptr<uint8_t[]> contents =
+        std::make_shared<uint8_t[]>(count * block_size);
+    std::span<uint8_t> dest(contents.get(), count * block_size);
+
+    if (local)
+      local->read(keys, dest);
+    else
+      remote->read(keys, dest);
+
+    transfer_image(temporary, keys, dest, true);
+    thread_safe_log_with_id(
+        std::format("Dumped {0} blocks to image {1}", count, path));
+  }
+
+  MPI_Barrier(worker_comm());
+  if (world_rank == MASTER_INSTANCE_ID &&
+      std::rename(temporary.c_str(), path.c_str()) != 0)
+    throw std::runtime_error(std::format("Failed to replace image {0}", path));
 }
 
 /**
- * Read contents from block indexed by `key`
+ * Read contents from every block indexed by `keys` into consecutive blocks of
+ * `dest`, in order; remote fetches are started first, so that local blocks are
+ * copied while they are in flight (blocks that migrated away meanwhile are
+ * then read remotely)
  */
-inline block UnifiedRepositoryFacade::read(int key) {
-  return access_map.at(key)->read(key);
+inline void UnifiedRepositoryFacade::read(const std::vector<int> &keys,
+                                          std::span<uint8_t> dest) {
+  if (!keys.empty()) {
+    std::vector<int> ahead;
+    for (int key : prefetcher->on_access(keys.front(), keys.size()))
+      if (!is_local(key))
+        ahead.push_back(key);
+
+    if (!ahead.empty())
+      remote->prefetch(ahead);
+  }
+
+  settle(keys);
+  std::vector<int> remote_keys, local_keys;
+  std::vector<size_t> remote_indexes, local_indexes;
+  for (size_t i = 0; i < keys.size(); i++) {
+    bool is_remote = !is_local(keys[i]);
+    (is_remote ? remote_keys : local_keys).push_back(keys[i]);
+    (is_remote ? remote_indexes : local_indexes).push_back(i);
+  }
+
+  if (remote_keys.size() == keys.size())
+    return remote->read(keys, dest);
+
+  std::vector<std::future<block>> futures = remote->read_async(remote_keys);
+
+  std::vector<size_t> moved = with_local(
+      local_keys, world_rank, [&](const std::vector<size_t> &indexes) {
+        for (size_t i : indexes)
+          local->read(local_keys[i], block_subspan(dest, local_indexes[i]));
+      });
+  for (size_t i : moved)
+    remote->read(local_keys[i], block_subspan(dest, local_indexes[i]));
+
+  for (size_t i = 0; i < futures.size(); i++)
+    copy_block(block_view(futures[i].get().get(), block_size),
+               block_subspan(dest, remote_indexes[i]));
 }
 
 /**
@@ -333,7 +2811,7 @@ inline block UnifiedRepositoryFacade::read(int key) {
  * logging purposes)
  */
 inline std::map<int, block> UnifiedRepositoryFacade::dump() {
-  std::map<int, block> l = local->dump();
+  std::map<int, block> l = local ? local->dump() : std::map<int, block>();
   std::map<int, block> r = remote->dump();
   l.merge(r);
 
@@ -341,17 +2819,128 @@ inline std::map<int, block> UnifiedRepositoryFacade::dump() {
 }
 
 /**
- * Clear locally cached data for block identified by `key` (remote only)
+ * Clear locally cached data for block identified by `key` (no-op if it is
+ * maintained here)
  */
 inline void UnifiedRepositoryFacade::invalidate_cache(int key) {
-  std::vector<int> local_blocks =
-      mem_map.at(registry_get(GlobalRegistryIndex::WorldRank));
-  std::set<int> local_set = std::set(local_blocks.begin(), local_blocks.end());
+  if (!is_local(key))
+    remote->invalidate_cache(key);
+}
+
+inline void
+UnifiedRepositoryFacade::invalidate_cache(const NotificationBatch &batch) {
+  for (size_t i = 0; i < batch.keys.size(); i++)
+    if (!is_local(batch.keys[i]))
+      remote->invalidate_cache(batch.keys[i], batch.versions[i]);
+}
+
+inline void
+UnifiedRepositoryFacade::read_forwarded(ForwardedReadMessageBuffer &message) {
+  std::vector<int> keys;
+  std::vector<size_t> indexes;
+  for (size_t i = 0; i < message.request.keys.size(); i++)
+    if (message.versions[i] == BLOCK_VERSION_NONE) {
+      keys.push_back(message.request.keys[i]);
+      indexes.push_back(i);
+    }
+
+  auto read = [&](const std::vector<size_t> &local_indexes) {
+    std::vector<int> local_keys;
+    for (size_t i : local_indexes)
+      local_keys.push_back(keys[i]);
+
+    if (registry_get(GlobalRegistryIndex::Coherence) == COHERENCE_DIRECTORY)
+      local->add_sharer(local_keys, message.origin);
+
+    for (size_t i : local_indexes)
+      message.versions[indexes[i]] = local->read_versioned(
+          keys[i], std::span<uint8_t>(message.contents.get() +
+                                          indexes[i] * block_size,
+                                      block_size));
+  };
+
+  // Replicas never migrate, so they are read without taking any guard
+  std::vector<size_t> replica_indexes;
+  for (size_t i = 0; i < keys.size(); i++)
+    if (local && is_replica_holder(keys[i], world_rank))
+      replica_indexes.push_back(i);
+
+  if (!replica_indexes.empty())
+    read(replica_indexes);
+
+  with_local(keys, message.origin, read);
+}
+
+inline void UnifiedRepositoryFacade::replicate(const ReplicaUpdateBatch &batch) {
+  if (!local)
+    throw std::runtime_error("Bad index");
+
+  local->replicate(batch);
+}
+
+inline std::vector<WriteMessageBuffer> UnifiedRepositoryFacade::write_forwarded(
+    int origin, const std::vector<WriteMessageBuffer> &entries) {
+  std::vector<int> keys;
+  for (const WriteMessageBuffer &entry : entries)
+    keys.push_back(entry.key);
+
+  std::vector<size_t> remote_indexes =
+      with_local(keys, origin, [&](const std::vector<size_t> &indexes) {
+        std::vector<WriteMessageBuffer> local_entries;
+        for (size_t i : indexes)
+          local_entries.push_back(entries[i]);
+        local->write(local_entries);
+      });
+
+  std::vector<WriteMessageBuffer> remaining;
+  for (size_t i : remote_indexes)
+    remaining.push_back(entries[i]);
+  return remaining;
+}
 
-  if (local_set.contains(key))
+/**
+ * Any copy of the block cached here is dropped first, since it would go stale
+ * (unnoticed) if the block ever migrated away again
+ */
+inline void
+UnifiedRepositoryFacade::adopt(const MigrationMessageBuffer &message) {
+  if (!tracker)
     throw std::runtime_error("Bad index");
 
-  static_cast<RemoteRepository &>(*access_map.at(key)).invalidate_cache(key);
+  {
+    std::lock_guard lock(ownership->mtx);
+    ownership->epochs.at(message.key) = message.epoch;
+  }
+
+  thread_safe_log_with_id(
+      std::format("Adopting block {0} at version {1} (migration {2})",
+                  message.key, message.version, message.epoch));
+
+  remote->invalidate_cache(message.key);
+  local->adopt(message.key, message.version, message.data);
+  ownership->adopted[message.key] = true;
+  set_maintainer(message.key, world_rank);
+}
+
+inline void
+UnifiedRepositoryFacade::relocate(const OwnershipMessageBuffer &message) {
+  {
+    std::lock_guard lock(ownership->mtx);
+    if (message.epoch <= ownership->epochs.at(message.key)) {
+      thread_safe_log_with_id(std::format(
+          "Ignoring stale maintainer {0} of block {1} (migration {2})",
+          message.maintainer, message.key, message.epoch));
+      return;
+    }
+
+    ownership->epochs[message.key] = message.epoch;
+    set_maintainer(message.key, message.maintainer);
+  }
+
+  thread_safe_log_with_id(std::format(
+      "Block {0} is now maintained by process of ID {1} (migration {2})",
+      message.key, message.maintainer, message.epoch));
+  remote->invalidate_cache(message.key);
 }
 
 #endif
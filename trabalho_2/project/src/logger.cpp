@@ -3,11 +3,6 @@
 #include <chrono>
 #include <iostream>
 
-/**
- * Creates a directory from (relative) `path`)
- */
-void create_directory(const std::string &path);
-
 /**
  * Returns UNIX-time epoch string
  */
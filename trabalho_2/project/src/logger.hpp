@@ -38,9 +38,13 @@ private:
 
 /**
  * Provides function API to perform a method call to the global
- * `ThreadSafeLogger` instance
+ * `ThreadSafeLogger` instance; returns early when logging is disabled, so that
+ * hot paths do not contend on the instance lock
  */
 inline void thread_safe_log(const std::string &msg) {
+  if (registry_get(GlobalRegistryIndex::LogLevel) <= 0)
+    return;
+
   ThreadSafeLogger::get_instance()->log(msg);
 }
 
@@ -66,4 +70,9 @@ inline void thread_safe_log_with_id(const std::string &msg) {
   thread_safe_log_with_id(msg, registry_get(GlobalRegistryIndex::WorldRank));
 }
 
+/**
+ * Creates a directory from (relative) `path`, along with its missing parents
+ */
+void create_directory(const std::string &path);
+
 #endif
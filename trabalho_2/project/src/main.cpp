@@ -1,3 +1,4 @@
+#include "bench.hpp"
 #include "constants.hpp"
 #include "lib.hpp"
 #include "logger.hpp"
@@ -5,7 +6,9 @@
 #include "store.hpp"
 #include "types.hpp"
 #include "utils.hpp"
+#include <algorithm>
 #include <format>
+#include <iterator>
 #include <memory>
 #include <mpi.h>
 #include <random>
@@ -52,10 +55,13 @@ int le(int posicao, std::shared_ptr<uint8_t[]> buffer, int tamanho);
 // *****************************************************************************
 
 /**
- * Starts all server threads and returns them `server_threads`:
+ * Starts all server threads and returns them `server_threads`; `subscriber`
+ * (if any) is progressed by the request dispatcher, which stops once
+ * `shutdown` is complete
  */
-server_threads start_helper_threads(memory_map mem_map,
-                                    UnifiedRepositoryFacade &repo);
+server_threads
+start_helper_threads(UnifiedRepositoryFacade &repo, ShutdownProtocol &shutdown,
+                     std::shared_ptr<NotificationSubscriber> subscriber);
 
 /**
  * Implements worker operations
@@ -63,6 +69,13 @@ server_threads start_helper_threads(memory_map mem_map,
 void worker_proc(memory_map mem_map, std::string processor_name, int block_size,
                  int num_blocks, int world_rank, int world_size);
 
+/**
+ * Runs random reads and writes, one at a time, until `--ops` operations were
+ * run or `--duration` milliseconds went by, then reports how long they took;
+ * if neither is set, runs forever, pausing after every operation
+ */
+void run_random_operations(int num_blocks, int block_size);
+
 /**
  * Implements broadcaster operations
  */
@@ -83,6 +96,14 @@ int main(int argc, const char **argv) {
   MPI_Comm_size(MPI_COMM_WORLD, &world_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
   MPI_Get_processor_name(processor_name, &name_len);
+  MPI_Comm_dup(MPI_COMM_WORLD, &request_comm());
+  MPI_Comm_dup(MPI_COMM_WORLD, &notification_comm());
+  MPI_Comm_dup(MPI_COMM_WORLD, &shutdown_comm());
+  MPI_Comm_split(MPI_COMM_WORLD,
+                 world_rank == get_broadcaster_proc_rank(world_size)
+                     ? MPI_UNDEFINED
+                     : 0,
+                 world_rank, &worker_comm());
 
   std::cout << "Process assigned world rank " << world_rank
             << " successfully initialized MPI" << std::endl;
@@ -93,7 +114,13 @@ int main(int argc, const char **argv) {
   }
 
   const bool verbose = is_verbose(world_rank);
-  program_args params = capture_args(argc, argv, verbose);
+  std::vector<const char *> positional_args;
+  std::copy_if(argv, argv + argc, std::back_inserter(positional_args),
+               [](const char *arg) { return !is_option_arg(arg); });
+
+  program_args params =
+      capture_args(positional_args.size(), positional_args.data(), verbose);
+  program_options options = capture_options(argc, argv, verbose);
 
   std::cout << "Process assigned world rank " << world_rank
             << " successfully parsed program args" << std::endl;
@@ -109,7 +136,8 @@ int main(int argc, const char **argv) {
             << " successfully validated program args" << std::endl;
 
   std::shared_ptr<GlobalRegistry> registry = GlobalRegistry::get_instance(
-      world_rank, world_size, num_blocks, block_size, timestamp, log_level);
+      world_rank, world_size, num_blocks, block_size, timestamp, log_level,
+      options);
   memory_map mem_map = resolve_maintainers();
 
   if (world_rank == get_broadcaster_proc_rank(world_size)) {
@@ -119,6 +147,14 @@ int main(int argc, const char **argv) {
                 world_size);
   }
 
+  // Every process is done with every communicator past this point
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  if (worker_comm() != MPI_COMM_NULL)
+    MPI_Comm_free(&worker_comm());
+  MPI_Comm_free(&shutdown_comm());
+  MPI_Comm_free(&notification_comm());
+  MPI_Comm_free(&request_comm());
   MPI_Finalize();
   return 0;
 }
@@ -127,21 +163,85 @@ void worker_proc(memory_map mem_map, std::string processor_name, int block_size,
                  int num_blocks, int world_rank, int world_size) {
   thread_safe_log_with_id("Started as worker process");
 
-  std::mt19937 rng{std::random_device{}()};
   repository = UnifiedRepositoryFacade(mem_map, block_size, world_rank);
 
+  std::shared_ptr<NotificationSubscriber> subscriber;
+  if (registry_get(GlobalRegistryIndex::Coherence) == COHERENCE_BROADCAST)
+    subscriber = std::make_shared<NotificationSubscriber>(repository.value());
+
+  ShutdownProtocol shutdown;
   server_threads threads =
-      start_helper_threads(mem_map, std::ref(repository.value()));
+      start_helper_threads(std::ref(repository.value()), shutdown, subscriber);
 
   thread_safe_log_with_id("Started helper threads");
 
+  if (is_restore_enabled())
+    repository->restore();
+
+  if (registry_get(GlobalRegistryIndex::Load))
+    repository->load(IMAGE_PATH);
+
   MPI_Barrier(MPI_COMM_WORLD);
 
   thread_safe_log_with_id(std::format(
       "Hello, World! from processor {0}, rank {1} out of {2} processors",
       processor_name, world_rank, world_size));
 
-  while (true) {
+  int mode = registry_get(GlobalRegistryIndex::Mode);
+  if (mode == MODE_BENCH)
+    read_scaling_benchmark(repository.value());
+  else if (mode == MODE_WORKLOAD)
+    workload_benchmark(repository.value());
+  else
+    run_random_operations(num_blocks, block_size);
+
+  // Every request of this process must be complete before announcing it is
+  // done
+  repository->fence();
+  while (repository->progress())
+    std::this_thread::yield();
+
+  shutdown.announce();
+  std::apply([](auto &&...thread) { ((thread.join()), ...); }, threads);
+  if (subscriber)
+    subscriber->drain();
+
+  thread_safe_log_with_id("Stopped helper threads");
+
+  // Releases the RMA window (a collective over `worker_comm`) ahead of
+  // `MPI_Finalize`
+  repository.reset();
+}
+
+void run_random_operations(int num_blocks, int block_size) {
+  std::mt19937 rng{std::random_device{}()};
+
+  int checkpoint_interval =
+      registry_get(GlobalRegistryIndex::CheckpointInterval);
+  int dump_interval = registry_get(GlobalRegistryIndex::DumpInterval);
+  if (dump_interval > 0)
+    create_directory(STORAGE_DIR);
+
+  long max_operations = registry_get(GlobalRegistryIndex::OperationCount);
+  double duration =
+      registry_get(GlobalRegistryIndex::DurationMillis) / 1000.0;
+  // Bounded runs are measured, so they go without pausing between operations
+  bool paced = max_operations == 0 && duration == 0;
+  double start = MPI_Wtime();
+  long operations = 0;
+
+  while (max_operations == 0 || operations < max_operations) {
+    // Workers agree on when the run is over, so that they all take part in the
+    // same checkpoints (and dumps)
+    if (duration > 0) {
+      int expired = MPI_Wtime() - start >= duration;
+      MPI_Allreduce(MPI_IN_PLACE, &expired, 1, MPI_INT, MPI_LOR,
+                    worker_comm());
+      if (expired)
+        break;
+    }
+
+    operations++;
     int target_block = rng() % num_blocks;
     int size = rng() % ((num_blocks - target_block) * block_size);
 
@@ -154,8 +254,18 @@ void worker_proc(memory_map mem_map, std::string processor_name, int block_size,
       le(target_block, result_buffer, size);
     }
 
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(OPERATION_SLEEP_INTERVAL_MILLIS));
+    if (paced)
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(OPERATION_SLEEP_INTERVAL_MILLIS));
+
+    // Every worker runs the same number of operations between checkpoints (and
+    // dumps), so that they all take part in each of them
+    if (is_persistence_enabled() && checkpoint_interval > 0 &&
+        operations % checkpoint_interval == 0)
+      repository->checkpoint();
+
+    if (dump_interval > 0 && operations % dump_interval == 0)
+      repository->dump(IMAGE_PATH);
 
     if (registry_get(GlobalRegistryIndex::LogLevel) > 1)
       thread_safe_log_with_id(
@@ -163,28 +273,69 @@ void worker_proc(memory_map mem_map, std::string processor_name, int block_size,
                       dump_current_state(repository.value())));
   }
 
-  std::apply([](auto &&...thread) { ((thread.join()), ...); }, threads);
+  // Writes still buffered or unacknowledged are part of the run
+  repository->fence();
+  double elapsed = MPI_Wtime() - start;
+  CacheStats stats = repository->cache_stats();
+  std::string summary = std::format(
+      "Completed {0} operations in {1} s (remote block cache: {2} hits, {3} "
+      "misses, {4} evictions)",
+      operations, elapsed, stats.hits, stats.misses, stats.evictions);
+  thread_safe_log_with_id(summary);
+  std::cout << std::format("Rank {0}: {1}",
+                           registry_get(GlobalRegistryIndex::WorldRank),
+                           summary)
+            << std::endl;
 }
 
 void broadcaster_proc() {
   thread_safe_log_with_id("Started as notification broadcaster");
 
-  std::thread t = std::thread(notification_broadcaster);
+  NotificationBatcher batcher(
+      registry_get(GlobalRegistryIndex::NotificationBatchSize),
+      std::chrono::microseconds(
+          registry_get(GlobalRegistryIndex::NotificationBatchWindowMicros)));
+  std::vector<progress_hook> progress_hooks = {
+      [&batcher] { return batcher.flush(); }};
+
+  ShutdownProtocol shutdown;
+  std::thread t =
+      std::thread(request_dispatcher, broadcaster_request_handler(batcher), 1,
+                  std::ref(shutdown), progress_hooks);
   MPI_Barrier(MPI_COMM_WORLD);
+
+  // The broadcaster issues no requests of its own
+  shutdown.announce();
   t.join();
+
+  if (registry_get(GlobalRegistryIndex::Coherence) == COHERENCE_BROADCAST)
+    batcher.close();
+
+  thread_safe_log_with_id("Stopped helper threads");
 }
 
-server_threads start_helper_threads(memory_map mem_map,
-                                    UnifiedRepositoryFacade &repo) {
-  return std::make_tuple(
-      std::thread(read_listener, mem_map, std::ref(repo)),
-      std::thread(write_listener, mem_map, std::ref(repo)),
-      std::thread(notification_listener, mem_map, std::ref(repo)));
+server_threads
+start_helper_threads(UnifiedRepositoryFacade &repo, ShutdownProtocol &shutdown,
+                     std::shared_ptr<NotificationSubscriber> subscriber) {
+  std::vector<progress_hook> progress_hooks = {
+      [&repo] { return repo.progress(); }};
+
+  if (subscriber)
+    progress_hooks.push_back([subscriber] { return subscriber->progress(); });
+
+  return std::make_tuple(std::thread(
+      request_dispatcher, worker_request_handler(repo),
+      REQUEST_HANDLER_POOL_SIZE, std::ref(shutdown), progress_hooks));
 }
 
 std::string dump_current_state(UnifiedRepositoryFacade &repo) {
   int num_blocks = registry_get(GlobalRegistryIndex::NumBlocks);
-  std::string s = "\n";
+  CacheStats stats = repo.cache_stats();
+  std::string s = std::format(
+      "(remote block cache: {0} hits, {1} misses, {2} evictions; {3} "
+      "prefetches, {4} useful, {5} wasted)\n",
+      stats.hits, stats.misses, stats.evictions, stats.prefetches,
+      stats.useful_prefetches, stats.wasted_prefetches);
   std::map<int, block> state = repo.dump();
 
   auto transform = [&](const std::pair<int, block> &p) {
@@ -208,14 +359,19 @@ int escreve(int posicao, std::shared_ptr<uint8_t[]> buffer, int tamanho) {
   if (final_pos > num_blocks)
     return 1;
 
+  std::vector<WriteMessageBuffer> entries;
   for (int i = 0; i < scoped_blocks; i++) {
-    block new_buf = std::make_shared<uint8_t[]>(block_size);
-    std::memcpy(new_buf.get(), buffer.get() + (i * block_size), block_size);
-    repository->write(posicao + i, new_buf);
-    thread_safe_log_with_id(std::format(
-        "Performing WRITE operation to block {0} at `main` level", posicao));
+    int length = std::min(block_size, tamanho - i * block_size);
+    block new_buf = std::make_shared<uint8_t[]>(length);
+    std::memcpy(new_buf.get(), buffer.get() + (i * block_size), length);
+    entries.push_back(WriteMessageBuffer(posicao + i, new_buf, 0, length));
   }
 
+  thread_safe_log_with_id(std::format(
+      "Performing WRITE operation to blocks {0} through {1} at `main` level",
+      posicao, final_pos - 1));
+  repository->write(entries);
+
   return 0;
 }
 
@@ -228,12 +384,14 @@ int le(int posicao, std::shared_ptr<uint8_t[]> buffer, int tamanho) {
   if (final_pos > num_blocks)
     return 1;
 
-  for (int i = 0; i < scoped_blocks; i++) {
-    block result = repository->read(posicao + i);
-    std::memcpy(buffer.get() + (i * block_size), result.get(), block_size);
-    thread_safe_log_with_id(std::format(
-        "Performing READ operation to block {0} at `main` level", posicao));
-  }
+  std::vector<int> keys;
+  for (int i = 0; i < scoped_blocks; i++)
+    keys.push_back(posicao + i);
+
+  thread_safe_log_with_id(std::format(
+      "Performing READ operation to blocks {0} through {1} at `main` level",
+      posicao, final_pos - 1));
+  repository->read(keys, std::span<uint8_t>(buffer.get(), tamanho));
 
   return 0;
 }
@@ -0,0 +1,28 @@
+#include "migration.hpp"
+#include <algorithm>
+
+MigrationTracker::MigrationTracker(int threshold, int world_rank)
+    : threshold(threshold), world_rank(world_rank) {}
+
+int MigrationTracker::record(int key, int requester) {
+  std::lock_guard lock(mtx);
+  Window &window = windows[key];
+  window.requesters[requester]++;
+  if (++window.total < threshold)
+    return -1;
+
+  auto top = std::max_element(
+      window.requesters.begin(), window.requesters.end(),
+      [](const auto &a, const auto &b) { return a.second < b.second; });
+  int target = top->first != world_rank && 2 * top->second > window.total
+                   ? top->first
+                   : -1;
+
+  windows.erase(key);
+  return target;
+}
+
+void MigrationTracker::forget(int key) {
+  std::lock_guard lock(mtx);
+  windows.erase(key);
+}
@@ -0,0 +1,47 @@
+#ifndef __MIGRATION_H__
+#define __MIGRATION_H__
+
+#include <map>
+#include <mutex>
+
+/**
+ * Counts the accesses to every block maintained by this process, by the
+ * process they were made on behalf of, and picks the blocks worth migrating.
+ *
+ * Accesses are counted in windows of `threshold` accesses per block; a window
+ * in which a single other process made more than half of them moves the block
+ * to that process
+ */
+class MigrationTracker {
+public:
+  MigrationTracker(int threshold, int world_rank);
+
+  /**
+   * Record an access to block indexed by `key` on behalf of process
+   * `requester`, returning the process the block should migrate to, or -1 if
+   * it should stay
+   */
+  int record(int key, int requester);
+
+  /**
+   * Drop the counts of block indexed by `key`, which no longer lives here
+   */
+  void forget(int key);
+
+private:
+  /**
+   * Accesses to a single block in the current window, in total and by
+   * requester
+   */
+  struct Window {
+    int total;
+    std::map<int, int> requesters;
+  };
+
+  std::mutex mtx;
+  std::map<int, Window> windows;
+  int threshold;
+  int world_rank;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "placement.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+BlockCyclicPlacement::BlockCyclicPlacement(int num_workers, int chunk_size)
+    : num_workers(num_workers), chunk_size(chunk_size) {}
+
+int BlockCyclicPlacement::maintainer_of(int key) const {
+  return key / chunk_size % num_workers;
+}
+
+RangePlacement::RangePlacement(int num_workers, int num_blocks)
+    : num_workers(num_workers),
+      range_size(std::max((num_blocks + num_workers - 1) / num_workers, 1)) {}
+
+int RangePlacement::maintainer_of(int key) const {
+  return std::min(key / range_size, num_workers - 1);
+}
+
+/**
+ * SplitMix64 finalizer; spreads nearby inputs (consecutive keys, or
+ * consecutive virtual nodes of a worker) evenly over the ring
+ */
+static uint64_t mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  return x ^ (x >> 31);
+}
+
+ConsistentHashPlacement::ConsistentHashPlacement(int num_workers,
+                                                 int num_blocks,
+                                                 int virtual_nodes)
+    : maintainers(num_blocks) {
+  // Virtual nodes are hashed off the worker's own hash rather than its plain
+  // index, so that they never coincide with the hash of a block key (worker 0's
+  // node `n` would otherwise hash exactly like key `n`)
+  std::vector<std::pair<uint64_t, int>> ring;
+  for (int worker = 0; worker < num_workers; worker++)
+    for (int node = 0; node < virtual_nodes; node++)
+      ring.emplace_back(mix(mix(worker) ^ node), worker);
+  std::sort(ring.begin(), ring.end());
+
+  for (int key = 0; key < num_blocks; key++) {
+    auto it = std::lower_bound(ring.begin(), ring.end(),
+                               std::make_pair(mix(key), 0));
+    maintainers[key] = it == ring.end() ? ring.front().second : it->second;
+  }
+}
+
+int ConsistentHashPlacement::maintainer_of(int key) const {
+  return maintainers.at(key);
+}
+
+std::unique_ptr<PlacementStrategy> make_placement(int placement,
+                                                  int num_workers,
+                                                  int num_blocks,
+                                                  int chunk_size) {
+  switch (placement) {
+  case PLACEMENT_CYCLIC:
+    return std::make_unique<BlockCyclicPlacement>(num_workers, chunk_size);
+  case PLACEMENT_RANGE:
+    return std::make_unique<RangePlacement>(num_workers, num_blocks);
+  case PLACEMENT_HASH:
+    return std::make_unique<ConsistentHashPlacement>(
+        num_workers, num_blocks, CONSISTENT_HASH_VIRTUAL_NODES);
+  default:
+    throw std::runtime_error(
+        std::format("Unknown block placement strategy {0}", placement));
+  }
+}
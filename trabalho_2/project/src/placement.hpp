@@ -0,0 +1,74 @@
+#ifndef __PLACEMENT_H__
+#define __PLACEMENT_H__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Assignment of every block to the worker process maintaining it; strategies
+ * are fixed for the whole run, so every process resolves the same maintainers
+ */
+class PlacementStrategy {
+public:
+  /**
+   * Resolves the ID of the worker maintaining block indexed by `key`
+   */
+  virtual int maintainer_of(int key) const = 0;
+  virtual ~PlacementStrategy() = default;
+};
+
+/**
+ * Block-cyclic placement: runs of `chunk_size` consecutive blocks are dealt to
+ * the workers in turn (a chunk size of 1 being plain round-robin)
+ */
+class BlockCyclicPlacement : public PlacementStrategy {
+public:
+  BlockCyclicPlacement(int num_workers, int chunk_size);
+  int maintainer_of(int key) const override;
+
+private:
+  int num_workers;
+  int chunk_size;
+};
+
+/**
+ * Range placement: blocks are split into `num_workers` contiguous ranges of
+ * (nearly) equal length, one per worker
+ */
+class RangePlacement : public PlacementStrategy {
+public:
+  RangePlacement(int num_workers, int num_blocks);
+  int maintainer_of(int key) const override;
+
+private:
+  int num_workers;
+  int range_size;
+};
+
+/**
+ * Consistent-hash placement: every worker owns `virtual_nodes` points of a hash
+ * ring, and each block belongs to the owner of the first point following its
+ * own hash; growing the number of workers only moves the blocks taken over by
+ * the new points. Maintainers are resolved once, at construction
+ */
+class ConsistentHashPlacement : public PlacementStrategy {
+public:
+  ConsistentHashPlacement(int num_workers, int num_blocks, int virtual_nodes);
+  int maintainer_of(int key) const override;
+
+private:
+  std::vector<int> maintainers;
+};
+
+/**
+ * Builds the strategy identified by `placement` (one of the `PLACEMENT_*`
+ * constants) over `num_blocks` blocks and `num_workers` workers; `chunk_size`
+ * only applies to block-cyclic placement
+ */
+std::unique_ptr<PlacementStrategy> make_placement(int placement,
+                                                  int num_workers,
+                                                  int num_blocks,
+                                                  int chunk_size);
+
+#endif
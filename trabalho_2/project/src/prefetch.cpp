@@ -0,0 +1,48 @@
+#include "prefetch.hpp"
+#include <algorithm>
+
+SequentialPrefetcher::SequentialPrefetcher(int max_depth, int num_blocks)
+    : max_depth(max_depth), num_blocks(num_blocks) {}
+
+std::vector<int> SequentialPrefetcher::on_access(int first_key, int count) {
+  std::vector<int> keys;
+  if (max_depth == 0 || count <= 0)
+    return keys;
+
+  std::lock_guard lock(mtx);
+  auto [it, created] = streams.try_emplace(std::this_thread::get_id(),
+                                           Stream(first_key, 0, 0, first_key));
+  Stream &stream = it->second;
+  int stride = first_key - stream.last_key;
+  stream.last_key = first_key;
+
+  if (created || stride == 0 || stride != stream.stride) {
+    stream.stride = stride;
+    stream.depth = 0;
+    return keys;
+  }
+
+  // Blocks up to `covered` (along the stride) were already accessed or
+  // predicted
+  if (stream.depth == 0)
+    stream.covered = stride > 0 ? first_key + count - 1 : first_key;
+  stream.depth = stream.depth == 0 ? 1 : std::min(2 * stream.depth, max_depth);
+
+  for (int i = 1; i <= stream.depth; i++) {
+    int start = first_key + i * stride;
+
+    if (stride > 0) {
+      for (int key = std::max(start, stream.covered + 1);
+           key < std::min(start + count, num_blocks); key++)
+        keys.push_back(key);
+      stream.covered = std::max(stream.covered, start + count - 1);
+    } else {
+      for (int key = std::max(start, 0);
+           key < std::min(start + count, stream.covered); key++)
+        keys.push_back(key);
+      stream.covered = std::min(stream.covered, start);
+    }
+  }
+
+  return keys;
+}
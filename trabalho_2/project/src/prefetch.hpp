@@ -0,0 +1,48 @@
+#ifndef __PREFETCH_H__
+#define __PREFETCH_H__
+
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Detects sequential or strided access streams, one per calling thread, and
+ * predicts the blocks they are about to read.
+ *
+ * An access is a read of consecutive blocks; once two consecutive accesses of
+ * a stream advance by the same (non-zero) stride, the next `depth` accesses
+ * along that stride are predicted. The depth starts at 1 and doubles on every
+ * access confirming the stride, up to `max_depth`, and falls back to 0 as soon
+ * as the stride changes
+ */
+class SequentialPrefetcher {
+public:
+  SequentialPrefetcher(int max_depth, int num_blocks);
+
+  /**
+   * Record an access of the calling thread to `count` blocks starting at
+   * `first_key`, returning the keys of the blocks predicted to be read next
+   * which were not predicted by an earlier access of the same stream
+   */
+  std::vector<int> on_access(int first_key, int count);
+
+private:
+  /**
+   * State of the access stream of a single thread; `covered` is the furthest
+   * key (along the stride) already accessed or predicted
+   */
+  struct Stream {
+    int last_key;
+    int stride;
+    int depth;
+    int covered;
+  };
+
+  std::mutex mtx;
+  std::map<std::thread::id, Stream> streams;
+  int max_depth;
+  int num_blocks;
+};
+
+#endif
@@ -5,6 +5,8 @@
 #include "store.hpp"
 #include "types.hpp"
 #include "utils.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <format>
@@ -14,159 +16,607 @@
 #include <thread>
 #include <unistd.h>
 
-void handle_read(std::set<int> &local_blocks, UnifiedRepositoryFacade &repo,
-                 int source);
+void handle_read(UnifiedRepositoryFacade &repo, Request &request);
 
-void handle_write(std::set<int> &local_blocks, UnifiedRepositoryFacade &repo,
-                  int source);
+void handle_write(UnifiedRepositoryFacade &repo, Request &request);
 
-void handle_notify(int source);
+void handle_invalidation(UnifiedRepositoryFacade &repo, Request &request);
 
-void read_listener(memory_map mem_map, UnifiedRepositoryFacade &repo) {
-  thread_safe_log_with_id("Read thread started");
+void handle_replica_update(UnifiedRepositoryFacade &repo, Request &request);
 
-  std::vector<int> local_blocks =
-      mem_map.at(registry_get(GlobalRegistryIndex::WorldRank));
-  std::set<int> local_set = std::set(local_blocks.begin(), local_blocks.end());
+void handle_migration(UnifiedRepositoryFacade &repo, Request &request);
 
+void handle_ownership(UnifiedRepositoryFacade &repo, Request &request);
+
+void handle_notify(NotificationBatcher &batcher, Request &request);
+
+HandlerPool::HandlerPool(int num_threads, request_handler handler)
+    : threads(), handler(handler), pending(0), stopped(false) {
+  for (int i = 0; i < num_threads; i++)
+    threads.push_back(std::make_unique<HandlerThread>());
+
+  for (auto &t : threads)
+    t->thread = std::thread(&HandlerPool::run, this, std::ref(*t));
+}
+
+void HandlerPool::submit(int shard, Request request) {
+  HandlerThread &t = *threads.at(shard % threads.size());
+  pending++;
+  {
+    std::lock_guard lock(t.mtx);
+    t.queue.push_back(std::move(request));
+  }
+  t.cv.notify_one();
+}
+
+void HandlerPool::run(HandlerThread &handler_thread) {
   while (true) {
-    thread_safe_log_with_id("Read listener probing...");
+    Request request;
+    {
+      std::unique_lock lock(handler_thread.mtx);
+      handler_thread.cv.wait(
+          lock, [&] { return stopped || !handler_thread.queue.empty(); });
 
-    int flag, probe_result;
-    MPI_Status status;
+      if (handler_thread.queue.empty())
+        return;
 
-    probe_result = MPI_Iprobe(MPI_ANY_SOURCE, MESSAGE_TAG_BLOCK_READ_REQUEST,
-                              MPI_COMM_WORLD, &flag, &status);
-    if (probe_result == MPI_SUCCESS && flag) {
-      thread_safe_log_with_id(
-          "Detected READ operation request at `listener` level");
-      handle_read(local_set, repo, status.MPI_SOURCE);
+      request = std::move(handler_thread.queue.front());
+      handler_thread.queue.pop_front();
     }
 
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(OPERATION_SLEEP_INTERVAL_MILLIS));
+    handler(request);
+    pending--;
   }
 }
 
-void write_listener(memory_map mem_map, UnifiedRepositoryFacade &repo) {
-  thread_safe_log_with_id("Write thread started");
+bool HandlerPool::is_idle() const { return pending.load() == 0; }
 
-  std::vector<int> local_blocks =
-      mem_map.at(registry_get(GlobalRegistryIndex::WorldRank));
-  std::set<int> local_set = std::set(local_blocks.begin(), local_blocks.end());
+HandlerPool::~HandlerPool() {
+  for (auto &t : threads) {
+    std::lock_guard lock(t->mtx);
+    stopped = true;
+  }
 
-  while (true) {
-    thread_safe_log_with_id("Write listener probing...");
+  for (auto &t : threads) {
+    t->cv.notify_all();
+    t->thread.join();
+  }
+}
 
-    int flag, probe_result;
-    MPI_Status status;
+NotificationBatcher::NotificationBatcher(int max_keys,
+                                         std::chrono::microseconds window)
+    : pending(), max_keys(max_keys), window(window) {}
 
-    probe_result = MPI_Iprobe(MPI_ANY_SOURCE, MESSAGE_TAG_BLOCK_WRITE_REQUEST,
-                              MPI_COMM_WORLD, &flag, &status);
+void NotificationBatcher::add(int key, block_version version) {
+  std::lock_guard lock(mtx);
+  if (pending.empty())
+    first_arrival = std::chrono::steady_clock::now();
 
-    if (probe_result == MPI_SUCCESS && flag) {
-      thread_safe_log_with_id(
-          "Detected WRITE operation request at `listener` level");
-      handle_write(local_set, repo, status.MPI_SOURCE);
+  block_version &latest = pending[key];
+  latest = std::max(latest, version);
+}
+
+bool NotificationBatcher::flush() {
+  while (!in_flight.empty()) {
+    int flag;
+    int test_result =
+        MPI_Test(&in_flight.front().second, &flag, MPI_STATUS_IGNORE);
+
+    if (test_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while testing NOTIFICATION "
+                               "broadcast at `batcher` level");
+    if (!flag)
+      break;
+
+    in_flight.pop_front();
+  }
+
+  NotificationBatch batch;
+  {
+    std::lock_guard lock(mtx);
+    if (pending.empty())
+      return !in_flight.empty();
+
+    if (static_cast<int>(pending.size()) < max_keys &&
+        std::chrono::steady_clock::now() - first_arrival < window)
+      return true;
+
+    // Keys past `max_keys` stay pending, still due since `first_arrival`, and
+    // go out on the next call
+    auto it = pending.begin();
+    for (; it != pending.end() &&
+           static_cast<int>(batch.keys.size()) < max_keys;
+         it++) {
+      batch.keys.push_back(it->first);
+      batch.versions.push_back(it->second);
     }
+    pending.erase(pending.begin(), it);
+  }
+
+  auto &[message_buffer, request] = in_flight.emplace_back(
+      encode_notification_batch(batch, max_keys), MPI_REQUEST_NULL);
+
+  int bcast_result = MPI_Ibcast(
+      message_buffer.get(), get_total_notification_batch_buffer_size(max_keys),
+      MPI_UNSIGNED_CHAR,
+      get_broadcaster_proc_rank(registry_get(GlobalRegistryIndex::WorldSize)),
+      notification_comm(), &request);
+
+  if (bcast_result != MPI_SUCCESS)
+    throw std::runtime_error(
+        "MPI error while attemption NOTIFICATION broadcast at `batcher` level");
+
+  thread_safe_log_with_id(std::format(
+      "Successfully started broadcast of NOTIFICATION batch for blocks {0}",
+      print_vec(batch.keys)));
+
+  return true;
+}
 
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(OPERATION_SLEEP_INTERVAL_MILLIS));
+void NotificationBatcher::close() {
+  // Every pending key is due at once from now on
+  window = std::chrono::microseconds(0);
+  while (flush())
+    std::this_thread::yield();
+
+  int size = get_total_notification_batch_buffer_size(max_keys);
+  int count = NOTIFICATION_BATCH_CLOSED;
+  std::shared_ptr<uint8_t[]> message_buffer = std::make_shared<uint8_t[]>(size);
+  std::memcpy(message_buffer.get(), &count, sizeof(int));
+
+  std::vector<MPI_Request> requests(NOTIFICATION_RING_DEPTH);
+  for (MPI_Request &request : requests) {
+    int bcast_result = MPI_Ibcast(
+        message_buffer.get(), size, MPI_UNSIGNED_CHAR,
+        get_broadcaster_proc_rank(registry_get(GlobalRegistryIndex::WorldSize)),
+        notification_comm(), &request);
+
+    if (bcast_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while attempting CLOSED broadcast at "
+                               "`batcher` level");
   }
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+  thread_safe_log_with_id("Closed NOTIFICATION broadcasts");
 }
 
-void notification_listener(memory_map mem_map, UnifiedRepositoryFacade &repo) {
-  thread_safe_log_with_id("Notification listener thread started");
-  int total_size = get_total_notification_message_buffer_size();
-  std::vector<int> local_blocks =
-      mem_map.at(registry_get(GlobalRegistryIndex::WorldRank));
-  std::set<int> local_set = std::set(local_blocks.begin(), local_blocks.end());
+ShutdownProtocol::ShutdownProtocol()
+    : announced(false), dispatched(0), contribution(0), total(0),
+      reduction(MPI_REQUEST_NULL), round(0), marker_sent(false),
+      completed(false) {}
+
+void ShutdownProtocol::announce() {
+  thread_safe_log_with_id("Announcing shutdown");
+  announced = true;
+}
+
+void ShutdownProtocol::receive_marker(const Request &request) {
+  if (request.size != static_cast<int>(sizeof(int)))
+    throw std::runtime_error(
+        "Malformed SHUTDOWN request received at `dispatcher` level");
+
+  int marker_round;
+  std::memcpy(&marker_round, request.payload.get(), sizeof(int));
+  markers[marker_round]++;
+}
+
+void ShutdownProtocol::count_request() { dispatched++; }
+
+/**
+ * Only workers issue requests, so the broadcaster sends no markers. Workers
+ * never send requests to themselves (requests forwarded back to a block's new
+ * maintainer are handled in place), so their own marker is counted directly.
+ * Markers are posted with `MPI_Isend`: the calling thread is the only one
+ * receiving from `request_comm`, so a blocking send could wait forever on a
+ * dispatcher blocked sending its own markers
+ */
+void ShutdownProtocol::send_markers() {
+  int world_size = registry_get(GlobalRegistryIndex::WorldSize);
+  int world_rank = registry_get(GlobalRegistryIndex::WorldRank);
+  if (world_rank == get_broadcaster_proc_rank(world_size))
+    return;
+
+  markers[round]++;
+  for (int rank = 0; rank < world_size; rank++) {
+    if (rank == world_rank)
+      continue;
+
+    MPI_Request &request = marker_requests.emplace_back();
+    int send_result =
+        MPI_Isend(&round, sizeof(int), MPI_UNSIGNED_CHAR, rank,
+                  MESSAGE_TAG_SHUTDOWN, request_comm(), &request);
+
+    if (send_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while attempting to send SHUTDOWN "
+                               "marker at `dispatcher` level");
+  }
+}
+
+bool ShutdownProtocol::progress(bool idle) {
+  if (completed || !announced.load())
+    return completed;
+
+  if (!marker_sent) {
+    if (!idle)
+      return false;
+
+    send_markers();
+    marker_sent = true;
+  }
+
+  int flag;
+  if (reduction == MPI_REQUEST_NULL) {
+    // `round` is the buffer of the markers in flight, so it must not change
+    // until they were all sent
+    int test_result =
+        MPI_Testall(marker_requests.size(), marker_requests.data(), &flag,
+                    MPI_STATUSES_IGNORE);
+
+    if (test_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while testing SHUTDOWN markers at "
+                               "`dispatcher` level");
+    if (!flag)
+      return false;
+
+    marker_requests.clear();
+    int num_workers =
+        get_num_worker_procs(registry_get(GlobalRegistryIndex::WorldSize));
+    if (markers[round] < num_workers || !idle)
+      return false;
+
+    contribution = dispatched;
+    dispatched = 0;
+    int reduce_result =
+        MPI_Iallreduce(&contribution, &total, 1, MPI_UINT64_T, MPI_SUM,
+                       shutdown_comm(), &reduction);
+
+    if (reduce_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while attempting SHUTDOWN reduction "
+                               "at `dispatcher` level");
+  }
+
+  int test_result = MPI_Test(&reduction, &flag, MPI_STATUS_IGNORE);
+  if (test_result != MPI_SUCCESS)
+    throw std::runtime_error("MPI error while testing SHUTDOWN reduction at "
+                             "`dispatcher` level");
+  if (!flag)
+    return false;
+
+  thread_safe_log_with_id(std::format(
+      "Shutdown round {0} dispatched {1} requests in total", round, total));
+
+  markers.erase(round);
+  round++;
+  marker_sent = false;
+  completed = total == 0;
+  return completed;
+}
+
+void request_dispatcher(request_handler handler, int num_handlers,
+                        ShutdownProtocol &shutdown,
+                        std::vector<progress_hook> progress_hooks) {
+  thread_safe_log_with_id("Request dispatcher started");
+
+  HandlerPool pool(num_handlers, handler);
+  int idle_spins = 0;
 
   while (true) {
-    thread_safe_log_with_id("Notification listener probing...");
-    std::shared_ptr<uint8_t[]> result_buffer =
-        std::make_shared<uint8_t[]>(total_size);
-    MPI_Bcast(
-        result_buffer.get(), total_size, MPI_UNSIGNED_CHAR,
-        get_broadcaster_proc_rank(registry_get(GlobalRegistryIndex::WorldSize)),
-        MPI_COMM_WORLD);
+    int flag, size;
+    MPI_Message message;
+    MPI_Status status;
+
+    int probe_result = MPI_Improbe(MPI_ANY_SOURCE, MPI_ANY_TAG, request_comm(),
+                                   &flag, &message, &status);
+
+    if (probe_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while probing for requests at "
+                               "`dispatcher` level");
+
+    bool pending_work = false;
+    for (progress_hook &hook : progress_hooks)
+      pending_work = hook() || pending_work;
+
+    if (pending_work)
+      idle_spins = 0;
+
+    if (!flag) {
+      if (shutdown.progress(pool.is_idle()))
+        break;
+
+      if (++idle_spins < DISPATCHER_IDLE_SPINS) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(DISPATCHER_IDLE_SLEEP_MICROS));
+      }
+      continue;
+    }
+
+    idle_spins = 0;
+    MPI_Get_count(&status, MPI_UNSIGNED_CHAR, &size);
+
+    Request request(status.MPI_SOURCE, status.MPI_TAG,
+                    std::make_shared<uint8_t[]>(size), size);
+
+    int recv_result = MPI_Mrecv(request.payload.get(), size, MPI_UNSIGNED_CHAR,
+                                &message, MPI_STATUS_IGNORE);
+
+    if (recv_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while receiving request at "
+                               "`dispatcher` level");
 
     thread_safe_log_with_id(
-        std::format("Received notification broadcast with message m = {0}",
-                    print_block(result_buffer, total_size)));
-    NotificationMessageBuffer message =
-        decode_notificaton_message(result_buffer);
+        std::format("Dispatching request of tag {0} from process of ID {1}",
+                    request.tag, request.source));
 
-    if (local_set.contains(message.key)) {
-      thread_safe_log_with_id(
-          "Skipping update notification for locally-maintained block...");
+    if (request.tag == MESSAGE_TAG_SHUTDOWN) {
+      shutdown.receive_marker(request);
       continue;
     }
 
-    thread_safe_log_with_id(std::format(
-        "Requesting cache invalidation for block {0}", message.key));
-    repo.invalidate_cache(message.key);
+    shutdown.count_request();
+
+    // Ownership changes are applied in the order they were received, ahead of
+    // any request received after them
+    if (is_dispatcher_request(request)) {
+      handler(request);
+      continue;
+    }
+
+    int shard = get_request_shard(request);
+    pool.submit(shard, std::move(request));
+  }
+
+  thread_safe_log_with_id("Request dispatcher stopped");
+}
+
+request_handler worker_request_handler(UnifiedRepositoryFacade &repo) {
+  return [&repo](Request &request) {
+    switch (request.tag) {
+    case MESSAGE_TAG_BLOCK_READ_REQUEST:
+    case MESSAGE_TAG_BLOCK_FORWARDED_READ:
+      thread_safe_log_with_id(
+          "Detected READ operation request at `listener` level");
+      handle_read(repo, request);
+      break;
+    case MESSAGE_TAG_BLOCK_WRITE_REQUEST:
+    case MESSAGE_TAG_BLOCK_FORWARDED_WRITE:
+      thread_safe_log_with_id(
+          "Detected WRITE operation request at `listener` level");
+      handle_write(repo, request);
+      break;
+    case MESSAGE_TAG_BLOCK_INVALIDATION:
+      thread_safe_log_with_id(
+          "Detected INVALIDATION operation request at `listener` level");
+      handle_invalidation(repo, request);
+      break;
+    case MESSAGE_TAG_BLOCK_REPLICA_UPDATE:
+      thread_safe_log_with_id(
+          "Detected REPLICA UPDATE operation request at `listener` level");
+      handle_replica_update(repo, request);
+      break;
+    case MESSAGE_TAG_BLOCK_MIGRATION:
+      thread_safe_log_with_id(
+          "Detected MIGRATION operation request at `listener` level");
+      handle_migration(repo, request);
+      break;
+    case MESSAGE_TAG_BLOCK_OWNERSHIP:
+      thread_safe_log_with_id(
+          "Detected OWNERSHIP operation request at `listener` level");
+      handle_ownership(repo, request);
+      break;
+    default:
+      throw std::runtime_error(std::format(
+          "Unexpected request of tag {0} at `listener` level", request.tag));
+    }
+  };
+}
+
+request_handler broadcaster_request_handler(NotificationBatcher &batcher) {
+  return [&batcher](Request &request) {
+    if (request.tag != MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION)
+      throw std::runtime_error(std::format(
+          "Unexpected request of tag {0} at `listener` level", request.tag));
+
+    thread_safe_log_with_id(
+        "Detected NOTIFIATON operation request at `listener` level");
+    handle_notify(batcher, request);
+  };
+}
+
+NotificationSubscriber::NotificationSubscriber(UnifiedRepositoryFacade &repo)
+    : ring(NOTIFICATION_RING_DEPTH), head(0), closed(0), repo(repo) {
+  buffer_size = get_total_notification_batch_buffer_size(
+      registry_get(GlobalRegistryIndex::NotificationBatchSize));
+
+  for (RingSlot &slot : ring) {
+    slot.buffer = std::make_shared<uint8_t[]>(buffer_size);
+    post(slot);
   }
 }
 
-void notification_broadcaster() {
-  thread_safe_log_with_id("Notification broadcaster server started");
+void NotificationSubscriber::post(RingSlot &slot) {
+  int bcast_result = MPI_Ibcast(
+      slot.buffer.get(), buffer_size, MPI_UNSIGNED_CHAR,
+      get_broadcaster_proc_rank(registry_get(GlobalRegistryIndex::WorldSize)),
+      notification_comm(), &slot.request);
 
-  while (true) {
-    thread_safe_log_with_id("Notification broadcaster probing...");
+  if (bcast_result != MPI_SUCCESS)
+    throw std::runtime_error("MPI error while posting NOTIFICATION broadcast "
+                             "at `subscriber` level");
+}
 
-    int flag, probe_result;
-    MPI_Status status;
+bool NotificationSubscriber::progress() {
+  bool handled = false;
+
+  while (closed < ring.size()) {
+    RingSlot &slot = ring[head];
+    int flag;
+    int test_result = MPI_Test(&slot.request, &flag, MPI_STATUS_IGNORE);
+
+    if (test_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while testing NOTIFICATION "
+                               "broadcast at `subscriber` level");
+    if (!flag)
+      return handled;
+
+    // CLOSED batches complete the broadcasts left posted, which are not
+    // posted again
+    if (decode_message_count(slot.buffer) == NOTIFICATION_BATCH_CLOSED) {
+      closed++;
+      head = (head + 1) % ring.size();
+      continue;
+    }
 
-    probe_result =
-        MPI_Iprobe(MPI_ANY_SOURCE, MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION,
-                   MPI_COMM_WORLD, &flag, &status);
+    NotificationBatch received = decode_notification_batch(slot.buffer);
+    int world_rank = registry_get(GlobalRegistryIndex::WorldRank);
+    NotificationBatch batch;
+    for (size_t i = 0; i < received.keys.size(); i++) {
+      if (resolve_maintainer(received.keys[i]) == world_rank)
+        continue;
 
-    if (probe_result == MPI_SUCCESS && flag) {
-      thread_safe_log_with_id(
-          "Detected NOTIFIATON operation request at `listener` level");
-      handle_notify(status.MPI_SOURCE);
+      batch.keys.push_back(received.keys[i]);
+      batch.versions.push_back(received.versions[i]);
     }
 
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(OPERATION_SLEEP_INTERVAL_MILLIS));
+    thread_safe_log_with_id(std::format(
+        "Received notification batch; requesting cache invalidation for "
+        "blocks {0}",
+        print_vec(batch.keys)));
+    repo.invalidate_cache(batch);
+
+    post(slot);
+    head = (head + 1) % ring.size();
+    handled = true;
   }
+
+  return handled;
+}
+
+void NotificationSubscriber::drain() {
+  while (closed < ring.size())
+    if (!progress())
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(DISPATCHER_IDLE_SLEEP_MICROS));
+
+  thread_safe_log_with_id("Received every NOTIFICATION broadcast");
 }
 
-void handle_read(std::set<int> &local_blocks, UnifiedRepositoryFacade &repo,
-                 int source) {
+/**
+ * Handles READ requests, as well as FORWARDED READ requests passed on by
+ * former maintainers of the blocks they target: blocks maintained here are
+ * read into the request, which is then forwarded to the maintainer of the
+ * first block still unread, if any, or answered to its origin otherwise
+ */
+void handle_read(UnifiedRepositoryFacade &repo, Request &request) {
   thread_safe_log_with_id(
       "Processing READ operation request at `handler` level...");
 
-  int requested_block;
-
-  int recv_result = MPI_Recv(&requested_block, 1, MPI_INT, source,
-                             MESSAGE_TAG_BLOCK_READ_REQUEST, MPI_COMM_WORLD,
-                             MPI_STATUS_IGNORE);
+  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  ForwardedReadMessageBuffer message;
+
+  if (request.tag == MESSAGE_TAG_BLOCK_READ_REQUEST) {
+    if (request.size < get_total_read_message_buffer_size(0) ||
+        request.size !=
+            get_total_read_message_buffer_size(
+                decode_message_count(request.payload, sizeof(int))))
+      throw std::runtime_error(
+          "Malformed READ request received at `handler` level");
+
+    message.origin = request.source;
+    message.request = decode_read_message(request.payload);
+    message.versions.assign(message.request.keys.size(), BLOCK_VERSION_NONE);
+    message.contents =
+        std::make_shared<uint8_t[]>(message.request.keys.size() * block_size);
+  } else {
+    if (request.size < get_total_forwarded_read_message_buffer_size(0) ||
+        request.size !=
+            get_total_forwarded_read_message_buffer_size(
+                decode_message_count(request.payload, 2 * sizeof(int))))
+      throw std::runtime_error(
+          "Malformed FORWARDED READ request received at `handler` level");
+
+    message = decode_forwarded_read_message(request.payload);
+  }
 
-  if (recv_result != MPI_SUCCESS)
-    throw std::runtime_error(
-        "MPI error while processing READ request at `handler` level");
+  int source = message.origin;
+  std::vector<int> &requested_blocks = message.request.keys;
 
   thread_safe_log_with_id(
       std::format("Successfully interpreted at `handler` level that targeted "
-                  "block for READ operation is {0}",
-                  requested_block));
-
-  if (!local_blocks.contains(requested_block))
-    throw std::runtime_error(
-        "Targeted block for READ operation is not maintained by this instance");
+                  "blocks for READ operation are {0}",
+                  print_vec(requested_blocks)));
   try {
-    block data = repo.read(requested_block);
+    int world_rank = registry_get(GlobalRegistryIndex::WorldRank);
+    auto first_unread = [&] {
+      return std::find(message.versions.begin(), message.versions.end(),
+                       BLOCK_VERSION_NONE);
+    };
+
+    // A block adopted here after `read_forwarded` checked it resolves to this
+    // very process; it is read again instead of being forwarded to self, which
+    // the SHUTDOWN markers would not account for
+    repo.read_forwarded(message);
+    auto unread = first_unread();
+    while (unread != message.versions.end() &&
+           resolve_maintainer(
+               requested_blocks[unread - message.versions.begin()]) ==
+               world_rank) {
+      repo.read_forwarded(message);
+      unread = first_unread();
+    }
+
+    if (unread != message.versions.end()) {
+      int key = requested_blocks[unread - message.versions.begin()];
+      int target = resolve_maintainer(key);
+
+      thread_safe_log_with_id(std::format(
+          "Forwarding READ request from process of ID {0} to process of ID "
+          "{1}, which maintains block {2} (request ID {3})",
+          source, target, key, message.request.request_id));
+
+      int send_result = MPI_Send(
+          encode_forwarded_read_message(message).get(),
+          get_total_forwarded_read_message_buffer_size(requested_blocks.size()),
+          MPI_UNSIGNED_CHAR, target, MESSAGE_TAG_BLOCK_FORWARDED_READ,
+          request_comm());
+
+      if (send_result != MPI_SUCCESS)
+        throw std::runtime_error("MPI error while attempting to forward READ "
+                                 "operation request at `handler` level");
+      return;
+    }
+
+    std::shared_ptr<uint8_t[]> response = std::make_shared<uint8_t[]>(
+        get_total_read_response_buffer_size(requested_blocks.size()));
+    std::memcpy(response.get(), &message.request.request_id, sizeof(int));
+
+    uint8_t *cursor = response.get() + sizeof(int);
+    int unmodified = 0;
+    for (size_t i = 0; i < requested_blocks.size(); i++) {
+      std::memcpy(cursor, &message.versions[i], sizeof(block_version));
+      cursor += sizeof(block_version);
+
+      if (message.versions[i] == message.request.versions[i]) {
+        unmodified++;
+      } else {
+        std::memcpy(cursor, message.contents.get() + i * block_size,
+                    block_size);
+        cursor += block_size;
+      }
+    }
+    int total_size = cursor - response.get();
+
     thread_safe_log_with_id(std::format(
         "Completed READ request from process of ID {0} successfully. Sending "
-        "out response for block {1}...",
-        source, requested_block));
+        "out response for blocks {1} ({2} of them unmodified; request ID "
+        "{3})...",
+        source, print_vec(requested_blocks), unmodified,
+        message.request.request_id));
 
-    int send_result =
-        MPI_Send(data.get(), registry_get(GlobalRegistryIndex::BlockSize),
-                 MPI_UNSIGNED_CHAR, source, MESSAGE_TAG_BLOCK_READ_RESPONSE,
-                 MPI_COMM_WORLD);
+    int send_result = MPI_Send(
+        response.get(), total_size, MPI_UNSIGNED_CHAR, source,
+        get_read_response_tag(message.request.request_id), MPI_COMM_WORLD);
 
     if (send_result != MPI_SUCCESS)
       throw std::runtime_error("MPI error while attempting to send response to "
@@ -178,60 +628,171 @@ void handle_read(std::set<int> &local_blocks, UnifiedRepositoryFacade &repo,
   }
 }
 
-void handle_write(std::set<int> &local_blocks, UnifiedRepositoryFacade &repo,
-                  int source) {
-  int total_size = get_total_write_message_buffer_size();
+/**
+ * Handles WRITE requests, as well as FORWARDED WRITE requests passed on by
+ * former maintainers of the blocks they target: entries for blocks maintained
+ * here are written, and the rest are forwarded to the maintainer of the first
+ * of them, if any; the request is acknowledged to its origin otherwise
+ */
+void handle_write(UnifiedRepositoryFacade &repo, Request &request) {
+  int source = request.source;
+  std::shared_ptr<uint8_t[]> result_buffer = request.payload;
+  int size = request.size;
 
   thread_safe_log_with_id(
       "Processing WRITE operation request at `handler` level...");
 
-  std::shared_ptr<uint8_t[]> result_buffer =
-      std::make_shared<uint8_t[]>(total_size);
-  int recv_result = MPI_Recv(result_buffer.get(), total_size, MPI_UNSIGNED_CHAR,
-                             source, MESSAGE_TAG_BLOCK_WRITE_REQUEST,
-                             MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  if (request.tag == MESSAGE_TAG_BLOCK_FORWARDED_WRITE) {
+    if (size < static_cast<int>(sizeof(int)))
+      throw std::runtime_error(
+          "Malformed FORWARDED WRITE request received at `handler` level");
 
-  if (recv_result != MPI_SUCCESS)
+    std::memcpy(&source, result_buffer.get(), sizeof(int));
+    result_buffer = std::shared_ptr<uint8_t[]>(
+        request.payload, request.payload.get() + sizeof(int));
+    size -= sizeof(int);
+  }
+
+  if (size < static_cast<int>(2 * sizeof(int)))
     throw std::runtime_error(
-        "MPI error while processing WRITE request at `handler` level");
+        "Malformed WRITE request received at `handler` level");
+
+  int sequence;
+  std::memcpy(&sequence, result_buffer.get(), sizeof(int));
 
   thread_safe_log_with_id(
       std::format("Successfully interpreted at `handler` "
                   "level WRITE operation coming from process of ID {0}; "
                   "request with total buffer contents {1}",
-                  source, print_block(result_buffer, total_size)));
+                  source, print_block(result_buffer, size)));
 
-  WriteMessageBuffer message_buffer = decode_write_message(result_buffer);
+  std::vector<WriteMessageBuffer> entries =
+      decode_write_message(result_buffer, size);
+  std::vector<WriteMessageBuffer> remaining;
 
-  if (!local_blocks.contains(message_buffer.key))
-    throw std::runtime_error("Targeted block for WRITE operation is not "
-                             "maintained by this instance");
   try {
-    repo.write(message_buffer.key, message_buffer.data);
-    thread_safe_log_with_id(
-        "Completed WRITE request from process of ID {0} successfully.");
+    // Entries for blocks adopted here after `write_forwarded` checked them are
+    // written again instead of being forwarded to self, which the SHUTDOWN
+    // markers would not account for
+    int world_rank = registry_get(GlobalRegistryIndex::WorldRank);
+    remaining = repo.write_forwarded(source, entries);
+    while (!remaining.empty() &&
+           resolve_maintainer(remaining.front().key) == world_rank)
+      remaining = repo.write_forwarded(source, remaining);
+    thread_safe_log_with_id(std::format(
+        "Completed WRITE request from process of ID {0} successfully.",
+        source));
   } catch (const std::exception &e) {
     throw std::runtime_error(
         "Encountered unexpected exception at `handler` level while attempting "
         "to process WRITE operation request");
   }
+
+  if (!remaining.empty()) {
+    int target = resolve_maintainer(remaining.front().key);
+    thread_safe_log_with_id(std::format(
+        "Forwarding {0} entries of WRITE request of sequence number {1} from "
+        "process of ID {2} to process of ID {3}",
+        remaining.size(), sequence, source, target));
+
+    int send_result = MPI_Send(
+        encode_forwarded_write_message(source, sequence, remaining).get(),
+        sizeof(int) + get_total_write_message_buffer_size(remaining),
+        MPI_UNSIGNED_CHAR, target, MESSAGE_TAG_BLOCK_FORWARDED_WRITE,
+        request_comm());
+
+    if (send_result != MPI_SUCCESS)
+      throw std::runtime_error("MPI error while attempting to forward WRITE "
+                               "operation request at `handler` level");
+    return;
+  }
+
+  int send_result = MPI_Send(&sequence, sizeof(int), MPI_UNSIGNED_CHAR, source,
+                             get_write_ack_tag(sequence), MPI_COMM_WORLD);
+
+  if (send_result != MPI_SUCCESS)
+    throw std::runtime_error("MPI error while attempting to acknowledge WRITE "
+                             "operation request at `handler` level");
+  thread_safe_log_with_id(std::format(
+      "Acknowledged WRITE request of sequence number {0} to process of ID {1}",
+      sequence, source));
 }
 
-void handle_notify(int source) {
+void handle_invalidation(UnifiedRepositoryFacade &repo, Request &request) {
+  thread_safe_log_with_id(
+      "Processing INVALIDATION operation request at `handler` level...");
+
+  if (request.size < static_cast<int>(sizeof(int)) ||
+      request.size != get_total_notification_batch_buffer_size(
+                          decode_message_count(request.payload)))
+    throw std::runtime_error(
+        "Malformed INVALIDATION request received at `handler` level");
+
+  NotificationBatch batch = decode_notification_batch(request.payload);
+
+  thread_safe_log_with_id(std::format(
+      "Requesting cache invalidation for blocks {0} written by process of ID "
+      "{1}",
+      print_vec(batch.keys), request.source));
+  repo.invalidate_cache(batch);
+}
+
+void handle_replica_update(UnifiedRepositoryFacade &repo, Request &request) {
+  thread_safe_log_with_id(
+      "Processing REPLICA UPDATE operation request at `handler` level...");
+
+  if (request.size < static_cast<int>(sizeof(int)) ||
+      request.size != get_total_replica_update_buffer_size(
+                          decode_message_count(request.payload)))
+    throw std::runtime_error(
+        "Malformed REPLICA UPDATE request received at `handler` level");
+
+  ReplicaUpdateBatch batch = decode_replica_update(request.payload);
+
+  thread_safe_log_with_id(
+      std::format("Updating replicas of blocks {0} pushed by process of ID {1}",
+                  print_vec(batch.keys), request.source));
+  repo.replicate(batch);
+}
+
+void handle_migration(UnifiedRepositoryFacade &repo, Request &request) {
+  thread_safe_log_with_id(
+      "Processing MIGRATION operation request at `handler` level...");
+
+  if (request.size != get_total_migration_message_buffer_size())
+    throw std::runtime_error(
+        "Malformed MIGRATION request received at `handler` level");
+
+  MigrationMessageBuffer message = decode_migration_message(request.payload);
+
+  thread_safe_log_with_id(
+      std::format("Block {0} was handed over by process of ID {1}",
+                  message.key, request.source));
+  repo.adopt(message);
+}
+
+void handle_ownership(UnifiedRepositoryFacade &repo, Request &request) {
+  thread_safe_log_with_id(
+      "Processing OWNERSHIP operation request at `handler` level...");
+
+  if (request.size != get_total_ownership_message_buffer_size())
+    throw std::runtime_error(
+        "Malformed OWNERSHIP request received at `handler` level");
+
+  repo.relocate(decode_ownership_message(request.payload));
+}
+
+void handle_notify(NotificationBatcher &batcher, Request &request) {
   int total_size = get_total_notification_message_buffer_size();
+  int source = request.source;
+  std::shared_ptr<uint8_t[]> result_buffer = request.payload;
 
   thread_safe_log_with_id(
       "Processing NOTIFICATION operation request at `handler` level...");
 
-  std::shared_ptr<uint8_t[]> result_buffer =
-      std::make_shared<uint8_t[]>(total_size);
-  int recv_result = MPI_Recv(result_buffer.get(), total_size, MPI_UNSIGNED_CHAR,
-                             source, MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION,
-                             MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-  if (recv_result != MPI_SUCCESS)
+  if (request.size != total_size)
     throw std::runtime_error(
-        "MPI error while processing NOTIFICATION request at `handler` level");
+        "Malformed NOTIFICATION request received at `handler` level");
 
   thread_safe_log_with_id(
       std::format("Successfully interpreted at `handler` "
@@ -239,19 +800,9 @@ void handle_notify(int source) {
                   "request with total buffer contents {1}",
                   source, print_block(result_buffer, total_size)));
 
-  decode_notificaton_message(
-      result_buffer); // DEBUG: Decoding to print out struct repr.
-
-  int bcast_result = MPI_Bcast(
-      result_buffer.get(), total_size, MPI_UNSIGNED_CHAR,
-      get_broadcaster_proc_rank(registry_get(GlobalRegistryIndex::WorldSize)),
-      MPI_COMM_WORLD);
-
-  if (bcast_result != MPI_SUCCESS)
-    throw std::runtime_error(
-        "MPI error while attemption NOTIFICATION broadcast at `handler` level");
+  NotificationMessageBuffer message = decode_notificaton_message(result_buffer);
+  batcher.add(message.key, message.version);
 
   thread_safe_log_with_id(std::format(
-      "Successfully submitted broadcast message with total contents {0}",
-      print_block(result_buffer, total_size)));
+      "Added block {0} to the pending NOTIFICATION batch", message.key));
 }
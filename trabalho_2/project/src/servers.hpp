@@ -3,31 +3,218 @@
 
 #include "lib.hpp"
 #include "types.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <mpi.h>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
 /**
- * Listener/subscriber loop that will handle incoming READ operations
- * identified by `MESSAGE_TAG_BLOCK_READ_REQUEST`
+ * Fixed-size pool of request handler threads. Each thread owns a FIFO queue,
+ * so that requests submitted under the same shard are handled in the order
+ * they were received, while requests on different shards run in parallel
  */
-void read_listener(memory_map mem_map, UnifiedRepositoryFacade &repo);
+class HandlerPool {
+public:
+  HandlerPool(int num_threads, request_handler handler);
+
+  /**
+   * Enqueue `request` for processing by the thread responsible for `shard`
+   */
+  void submit(int shard, Request request);
+
+  /**
+   * Whether every request submitted so far was handled
+   */
+  bool is_idle() const;
+  ~HandlerPool();
+
+private:
+  struct HandlerThread {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Request> queue;
+    std::thread thread;
+  };
+
+  void run(HandlerThread &handler_thread);
+
+  std::vector<std::unique_ptr<HandlerThread>> threads;
+  request_handler handler;
+  std::atomic<int> pending;
+  bool stopped;
+};
 
 /**
- * Listener/subscriber loop that will handle incoming WRITE operations
- * identified by `MESSAGE_TAG_BLOCK_WRITE_REQUEST`
+ * Gathers the keys of inbound NOTIFICATION requests at the broadcaster, so that
+ * they are broadcast as a single deduplicated batch once `max_keys` distinct
+ * keys are pending or `window` has elapsed since the first of them arrived
  */
-void write_listener(memory_map mem_map, UnifiedRepositoryFacade &repo);
+class NotificationBatcher {
+public:
+  NotificationBatcher(int max_keys, std::chrono::microseconds window);
+
+  /**
+   * Add `key`, written at `version`, to the pending batch; a key added more
+   * than once is broadcast with its latest version
+   */
+  void add(int key, block_version version);
+
+  /**
+   * Start broadcasting a batch of up to `max_keys` pending keys over
+   * `notification_comm` (with `MPI_Ibcast`) if it is due, and retire completed
+   * broadcasts; returns `true` while keys or broadcasts are pending. Must be
+   * called from a single thread
+   */
+  bool flush();
+
+  /**
+   * Broadcast every pending key at once, followed by `NOTIFICATION_RING_DEPTH`
+   * CLOSED batches, which complete every broadcast the subscribers keep
+   * posted, and wait for all of them; no key may be added afterwards. Must be
+   * called from the thread calling `flush`, once it no longer does
+   */
+  void close();
+
+private:
+  std::mutex mtx;
+  std::map<int, block_version> pending;
+  std::deque<std::pair<std::shared_ptr<uint8_t[]>, MPI_Request>> in_flight;
+  std::chrono::steady_clock::time_point first_arrival;
+  int max_keys;
+  std::chrono::microseconds window;
+};
 
 /**
- * Listener/subscriber loop that will handle incoming notifications
- * identified by `MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION`
+ * Termination detection for the request dispatchers of every process, so that
+ * they only stop once no request is left in transit anywhere; handling a
+ * request may issue further ones (e.g. REPLICA UPDATE requests invalidating
+ * sharers), so every process being done with its own requests is not enough.
+ *
+ * Once its process is done issuing requests of its own (see `announce`), each
+ * dispatcher runs rounds: every worker posts a SHUTDOWN marker (tagged with
+ * the round) to every other process over `request_comm` once its handlers are
+ * idle, and counts its own directly. Every process whose markers were sent,
+ * that received the markers of all workers, and whose handlers are idle, adds
+ * the number of requests it dispatched during the round to a sum over
+ * `shutdown_comm`. Markers never overtake the requests sent before them, so
+ * once a round sums to zero, no request is left in transit, and every
+ * dispatcher stops.
+ *
+ * Every method but `announce` must be called from the request dispatcher
  */
-void notification_listener(memory_map mem_map, UnifiedRepositoryFacade &repo);
+class ShutdownProtocol {
+public:
+  ShutdownProtocol();
+
+  /**
+   * Record that this process will issue no further requests of its own; every
+   * request it issued must be complete
+   */
+  void announce();
+
+  /**
+   * Record the SHUTDOWN marker `request`
+   */
+  void receive_marker(const Request &request);
+
+  /**
+   * Count a request (other than a SHUTDOWN marker) dispatched
+   */
+  void count_request();
+
+  /**
+   * Advance the current round, given whether every request dispatched so far
+   * was handled; returns `true` once the protocol is complete
+   */
+  bool progress(bool idle);
+
+private:
+  void send_markers();
+
+  std::atomic<bool> announced;
+  std::map<int, int> markers;
+  std::vector<MPI_Request> marker_requests;
+  uint64_t dispatched;
+  uint64_t contribution;
+  uint64_t total;
+  MPI_Request reduction;
+  int round;
+  bool marker_sent;
+  bool completed;
+};
 
 /**
- * Listener/producer loop that will broadcast incoming notifications
- * identified by `MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION`
+ * Progress engine loop; performs matched probes (`MPI_Improbe`/`MPI_Mrecv`)
+ * for requests of any tag arriving on `request_comm` and hands them off to a
+ * `HandlerPool` of `num_handlers` threads running `handler`, except for those
+ * changing the maintainer of a block, which are handled inline, in order.
+ * Every iteration also runs `progress_hooks`; returns once `shutdown` is
+ * complete, after every request was handled
  */
-void notification_broadcaster();
+void request_dispatcher(request_handler handler, int num_handlers,
+                        ShutdownProtocol &shutdown,
+                        std::vector<progress_hook> progress_hooks = {});
+
+/**
+ * Builds the handler for incoming READ, WRITE and INVALIDATION operations
+ * identified by `MESSAGE_TAG_BLOCK_READ_REQUEST`,
+ * `MESSAGE_TAG_BLOCK_WRITE_REQUEST` and `MESSAGE_TAG_BLOCK_INVALIDATION`, for
+ * their FORWARDED counterparts, and for REPLICA UPDATE, MIGRATION and OWNERSHIP
+ * operations
+ */
+request_handler worker_request_handler(UnifiedRepositoryFacade &repo);
+
+/**
+ * Builds the handler for incoming notifications identified by
+ * `MESSAGE_TAG_BLOCK_UPDATE_NOTIFICATION`, which are gathered by `batcher` to
+ * be broadcast to the workers
+ */
+request_handler broadcaster_request_handler(NotificationBatcher &batcher);
+
+/**
+ * Receives the notification batches broadcast by the broadcaster instance
+ * without parking a thread inside the collective: a ring of
+ * `NOTIFICATION_RING_DEPTH` pre-allocated buffers is kept posted with
+ * `MPI_Ibcast`, and `progress` (run by the request dispatcher) handles
+ * completed broadcasts in order, re-posting their buffers, until CLOSED
+ * batches arrive
+ */
+class NotificationSubscriber {
+public:
+  NotificationSubscriber(UnifiedRepositoryFacade &repo);
+
+  /**
+   * Invalidate the blocks of every completed broadcast; returns `true` if any
+   * was handled
+   */
+  bool progress();
+
+  /**
+   * Handle every broadcast left, until the broadcaster closes the ring (see
+   * `NotificationBatcher::close`); must be called once `progress` no longer is
+   */
+  void drain();
+
+private:
+  struct RingSlot {
+    std::shared_ptr<uint8_t[]> buffer;
+    MPI_Request request;
+  };
+
+  void post(RingSlot &slot);
+
+  std::vector<RingSlot> ring;
+  size_t head;
+  size_t closed;
+  UnifiedRepositoryFacade &repo;
+  int buffer_size;
+};
 
 #endif
@@ -0,0 +1,107 @@
+#include "slab.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * File-backed slabs are mapped whole (page-aligned, so also cache-line
+ * aligned); a file of any other size than the slab's is resized, unless it was
+ * to be kept, which is refused instead of discarding its contents
+ */
+BlockSlab::BlockSlab(int capacity, int block_size, const std::string &path,
+                     bool keep)
+    : base(nullptr), slots(capacity), block_size(block_size), mapped_size(0) {
+  std::size_t size = size_bytes();
+  std::size_t padded = (size + SLAB_ALIGNMENT - 1) / SLAB_ALIGNMENT *
+                       SLAB_ALIGNMENT;
+
+  if (!path.empty()) {
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+      throw std::runtime_error(
+          std::format("Failed to open slab file {0}", path));
+
+    struct stat info;
+    mapped_size = std::max<std::size_t>(padded, 1);
+    bool reusable = fstat(fd, &info) == 0 &&
+                    static_cast<std::size_t>(info.st_size) == mapped_size;
+
+    if (keep && !reusable) {
+      close(fd);
+      throw std::runtime_error(std::format(
+          "Slab file {0} does not match the current block layout", path));
+    }
+
+    if (!reusable && ftruncate(fd, mapped_size) != 0) {
+      close(fd);
+      throw std::runtime_error(
+          std::format("Failed to resize slab file {0}", path));
+    }
+
+    void *mapping = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+      throw std::runtime_error(
+          std::format("Failed to map slab file {0}", path));
+
+    base = static_cast<uint8_t *>(mapping);
+    if (!keep || !reusable)
+      std::memset(base, 0, size);
+    return;
+  }
+
+  base = static_cast<uint8_t *>(
+      std::aligned_alloc(SLAB_ALIGNMENT, std::max<std::size_t>(padded, 1)));
+  if (base == nullptr)
+    throw std::bad_alloc();
+
+  std::memset(base, 0, size);
+}
+
+std::span<uint8_t> BlockSlab::at(int slot) {
+  if (slot < 0 || slot >= slots)
+    throw std::out_of_range(
+        std::format("Slot {0} out of slab bounds (capacity {1})", slot, slots));
+
+  return std::span<uint8_t>(base + static_cast<std::size_t>(slot) * block_size,
+                            block_size);
+}
+
+block_view BlockSlab::at(int slot) const {
+  if (slot < 0 || slot >= slots)
+    throw std::out_of_range(
+        std::format("Slot {0} out of slab bounds (capacity {1})", slot, slots));
+
+  return block_view(base + static_cast<std::size_t>(slot) * block_size,
+                    block_size);
+}
+
+int BlockSlab::capacity() const { return slots; }
+
+std::size_t BlockSlab::size_bytes() const {
+  return static_cast<std::size_t>(slots) * block_size;
+}
+
+uint8_t *BlockSlab::data() { return base; }
+
+bool BlockSlab::is_mapped() const { return mapped_size > 0; }
+
+void BlockSlab::sync() {
+  if (is_mapped() && msync(base, mapped_size, MS_SYNC) != 0)
+    throw std::runtime_error("Failed to write slab through to its file");
+}
+
+BlockSlab::~BlockSlab() {
+  if (is_mapped())
+    munmap(base, mapped_size);
+  else
+    std::free(base);
+}
@@ -0,0 +1,72 @@
+#ifndef __SLAB_H__
+#define __SLAB_H__
+
+#include "constants.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+/**
+ * Contiguous, cache-line-aligned storage for `capacity` memory blocks of
+ * `block_size` bytes each; blocks are laid out back to back and addressed
+ * densely by slot index.
+ *
+ * Slabs are kept in heap memory unless `path` is given, in which case they are
+ * a shared mapping of the file at `path` (created if missing); its contents
+ * are zeroed unless `keep` is set, so that a slab persisted by an earlier run
+ * is picked up as is
+ */
+class BlockSlab {
+public:
+  BlockSlab(int capacity, int block_size, const std::string &path = "",
+            bool keep = false);
+  BlockSlab(const BlockSlab &) = delete;
+  BlockSlab &operator=(const BlockSlab &) = delete;
+
+  /**
+   * Bounds-checked view over the block stored at `slot`
+   */
+  std::span<uint8_t> at(int slot);
+
+  /**
+   * Bounds-checked (read-only) view over the block stored at `slot`
+   */
+  block_view at(int slot) const;
+
+  /**
+   * Number of blocks the slab can hold
+   */
+  int capacity() const;
+
+  /**
+   * Size (in bytes) of the whole slab
+   */
+  std::size_t size_bytes() const;
+
+  /**
+   * Base address of the slab
+   */
+  uint8_t *data();
+
+  /**
+   * Whether the slab is a mapping of a file
+   */
+  bool is_mapped() const;
+
+  /**
+   * Write the contents of a file-backed slab through to its file, returning
+   * once they reached it (no-op for heap slabs)
+   */
+  void sync();
+  ~BlockSlab();
+
+private:
+  uint8_t *base;
+  int slots;
+  int block_size;
+  std::size_t mapped_size;
+};
+
+#endif
@@ -5,8 +5,9 @@
 std::shared_ptr<GlobalRegistry> GlobalRegistry::instance{nullptr};
 
 GlobalRegistry::GlobalRegistry(int world_rank, int world_size, int num_blocks,
-                               int block_size, int timestamp, int log_level)
-    : data() {
+                               int block_size, int timestamp, int log_level,
+                               program_options options)
+    : data(options) {
   data.emplace(GlobalRegistryIndex::WorldRank, world_rank);
   data.emplace(GlobalRegistryIndex::WorldSize, world_size);
   data.emplace(GlobalRegistryIndex::NumBlocks, num_blocks);
@@ -25,15 +26,17 @@ int GlobalRegistry::get(GlobalRegistryIndex key) {
 
 std::shared_ptr<GlobalRegistry>
 GlobalRegistry::get_instance(int world_rank, int world_size, int num_blocks,
-                             int block_size, int timestamp, int log_level) {
+                             int block_size, int timestamp, int log_level,
+                             program_options options) {
   if (instance.get() == nullptr) {
-    instance = std::shared_ptr<GlobalRegistry>(new GlobalRegistry(
-        world_rank, world_size, num_blocks, block_size, timestamp, log_level));
+    instance = std::shared_ptr<GlobalRegistry>(
+        new GlobalRegistry(world_rank, world_size, num_blocks, block_size,
+                           timestamp, log_level, options));
   }
   return instance;
 };
 
-std::shared_ptr<GlobalRegistry> GlobalRegistry::get_instance() {
+const std::shared_ptr<GlobalRegistry> &GlobalRegistry::get_instance() {
   if (instance.get() == nullptr) {
     throw std::runtime_error("Attempted access to GlobalRegistry attribute "
                              "with no initialized instance");
@@ -11,8 +11,41 @@ enum class GlobalRegistryIndex {
   BlockSize,
   Timestamp,
   LogLevel,
+  Backend,
+  Mode,
+  NotificationBatchSize,
+  NotificationBatchWindowMicros,
+  Coherence,
+  WriteMode,
+  WriteBufferSize,
+  WriteBufferWindowMicros,
+  WriteWindow,
+  CacheSize,
+  CachePolicy,
+  PrefetchDepth,
+  Placement,
+  PlacementChunkSize,
+  MigrationThreshold,
+  ReplicationFactor,
+  Storage,
+  Restore,
+  CheckpointInterval,
+  Load,
+  DumpInterval,
+  ReadRatio,
+  OperationBlocks,
+  KeyDistribution,
+  BenchThreads,
+  DurationMillis,
+  OperationCount,
 };
 
+/**
+ * Runtime options (passed in as `--<name>=<value>`), keyed by the registry
+ * entry they are stored at
+ */
+using program_options = std::map<GlobalRegistryIndex, int>;
+
 /**
  * Provides easy (read-only) static access to an instance-scoped immutable set
  * of attributes
@@ -20,7 +53,7 @@ enum class GlobalRegistryIndex {
 class GlobalRegistry {
 protected:
   GlobalRegistry(int world_rank, int world_size, int num_blocks, int block_size,
-                 int timestamp, int log_level);
+                 int timestamp, int log_level, program_options options);
 
 public:
   /**
@@ -33,12 +66,12 @@ public:
    */
   static std::shared_ptr<GlobalRegistry>
   get_instance(int world_rank, int world_size, int num_blocks, int block_size,
-               int timestamp, int log_level);
+               int timestamp, int log_level, program_options options = {});
 
   /**
    * Provides access to the global registry instance
    */
-  static std::shared_ptr<GlobalRegistry> get_instance();
+  static const std::shared_ptr<GlobalRegistry> &get_instance();
 
 private:
   static std::shared_ptr<GlobalRegistry> instance;
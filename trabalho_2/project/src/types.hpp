@@ -2,7 +2,9 @@
 #define __TYPES_H__
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -21,17 +23,43 @@ typedef std::tuple<int, std::string, int, int> program_args;
 /**
  * Represents the server/listener thread model as a tuple, wherein:
  *
- * `std::get<0>(server_threads)` returns `read_listener`
- * `std::get<1>(server_threads)` returns `write_listener`
- * `std::get<2>(server_threads)` returns `notification_listener`
+ * `std::get<0>(server_threads)` returns `request_dispatcher`
  */
-typedef std::tuple<std::thread, std::thread, std::thread> server_threads;
+typedef std::tuple<std::thread> server_threads;
 
 /**
  * "Block" datatype representation; each block is a bytearray size `BLOCK_SIZE`
  */
 using block = std::shared_ptr<std::uint8_t[]>;
 
+/**
+ * Read-only, bounds-checked view over a block of length `BLOCK_SIZE`, as held
+ * by its repository
+ */
+using block_view = std::span<const std::uint8_t>;
+
+/**
+ * Version of a block, bumped by its maintainer on every write to it; versions
+ * start at 1, so that `BLOCK_VERSION_NONE` never names an actual version
+ */
+using block_version = std::uint32_t;
+
+/**
+ * Counters of the remote block cache: reads served from it (`hits`), reads
+ * that had to fetch the block (`misses`), blocks dropped to make room for
+ * others (`evictions`), and blocks fetched ahead of time (`prefetches`), of
+ * which some were read from the cache (`useful_prefetches`) while others were
+ * evicted, invalidated or replaced before that (`wasted_prefetches`)
+ */
+struct CacheStats {
+  std::uint64_t hits;
+  std::uint64_t misses;
+  std::uint64_t evictions;
+  std::uint64_t prefetches;
+  std::uint64_t useful_prefetches;
+  std::uint64_t wasted_prefetches;
+};
+
 /**
  * Represents the distributed memory allocation between the multiple instances
  * of the program, wherein:
@@ -42,13 +70,70 @@ using block = std::shared_ptr<std::uint8_t[]>;
  */
 typedef std::vector<std::vector<int>> memory_map;
 
+/**
+ * `stuct` representation of the message buffer for READ messages to be sent
+ * over MPI; `request_id` is echoed back in the response, which is also tagged
+ * after it, so that concurrent reads to the same maintainer never cross
+ */
+struct ReadMessageBuffer {
+  int request_id;
+  std::vector<int> keys;
+
+  /**
+   * Version of the copy of each block cached by the requester
+   * (`BLOCK_VERSION_NONE` if there is none); blocks still at that version are
+   * answered without their contents
+   */
+  std::vector<block_version> versions;
+};
+
 /**
  * `stuct` representation of the message buffer for WRITE messages to be sent
- * over MPI
+ * over MPI; a single WRITE message may carry several of these entries. `data`
+ * holds the `length` bytes to be written starting at byte `offset` of the block
  */
 struct WriteMessageBuffer {
   int key;
   block data;
+  int offset;
+  int length;
+};
+
+/**
+ * `stuct` representation of the message buffer for FORWARDED READ messages:
+ * a READ `request` sent by process `origin` to a process that no longer
+ * maintains every block it targets, passed on from maintainer to maintainer.
+ * `versions` holds the version each block was read at (`BLOCK_VERSION_NONE`
+ * while not read yet), and `contents` its data, block after block
+ */
+struct ForwardedReadMessageBuffer {
+  int origin;
+  ReadMessageBuffer request;
+  std::vector<block_version> versions;
+  std::shared_ptr<uint8_t[]> contents;
+};
+
+/**
+ * `stuct` representation of the message buffer for MIGRATION messages, which
+ * hand block indexed by `key`, at `version`, over to a new maintainer; `epoch`
+ * counts the migrations of the block so far
+ */
+struct MigrationMessageBuffer {
+  int key;
+  int epoch;
+  block_version version;
+  block data;
+};
+
+/**
+ * `stuct` representation of the message buffer for OWNERSHIP messages, which
+ * announce that block indexed by `key` is maintained by `maintainer` as of its
+ * `epoch`-th migration
+ */
+struct OwnershipMessageBuffer {
+  int key;
+  int epoch;
+  int maintainer;
 };
 
 /**
@@ -57,7 +142,55 @@ struct WriteMessageBuffer {
  */
 struct NotificationMessageBuffer {
   int key;
+  block_version version;
   int64_t timestamp;
 };
 
+/**
+ * `stuct` representation of a NOTIFICATION batch broadcast over MPI (and of
+ * INVALIDATION messages, which share its layout): the keys of the written
+ * blocks, along with the version each of them was written at
+ */
+struct NotificationBatch {
+  std::vector<int> keys;
+  std::vector<block_version> versions;
+};
+
+/**
+ * `stuct` representation of a REPLICA UPDATE message, pushed by the maintainer
+ * of the written blocks to their read replicas: the keys of the blocks, along
+ * with the version each of them was read at and their data, block after block
+ */
+struct ReplicaUpdateBatch {
+  std::vector<int> keys;
+  std::vector<block_version> versions;
+  std::shared_ptr<uint8_t[]> contents;
+};
+
+/**
+ * Inbound request, as received (in full) by the request dispatcher, wherein:
+ *
+ * - `source` is the `world_rank` of the requesting instance;
+ * - `tag` is the MPI tag identifying the operation (`MESSAGE_TAG_*`);
+ * - `payload` holds the raw message buffer, `size` bytes long
+ */
+struct Request {
+  int source;
+  int tag;
+  std::shared_ptr<uint8_t[]> payload;
+  int size;
+};
+
+/**
+ * Callback invoked by the handler threads for every dispatched `Request`
+ */
+using request_handler = std::function<void(Request &)>;
+
+/**
+ * Callback invoked by the request dispatcher on every iteration, so that
+ * outstanding non-blocking operations make progress; returns `true` while there
+ * is pending work
+ */
+using progress_hook = std::function<bool()>;
+
 #endif
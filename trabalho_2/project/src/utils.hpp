@@ -3,14 +3,23 @@
 
 #include "constants.hpp"
 #include "logger.hpp"
+#include "placement.hpp"
 #include "store.hpp"
 #include "types.hpp"
+#include <algorithm>
+#include <atomic>
 #include <bitset>
+#include <cstddef>
 #include <cstring>
 #include <format>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mpi.h>
 #include <set>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -39,6 +48,17 @@ inline std::string print_block(const block &b) {
   return msg;
 }
 
+/**
+ * Formats `types::block_view` to pretty-print friendly representation
+ */
+inline std::string print_block(block_view b) {
+  std::string msg;
+  for (uint8_t byte : b) {
+    msg += std::bitset<8>(byte).to_string() + " ";
+  }
+  return msg;
+}
+
 /**
  * Formats byte arrays of variable size to pretty-print friendly representation
  */
@@ -50,6 +70,28 @@ inline std::string print_block(std::shared_ptr<uint8_t[]> b, int size) {
   return msg;
 }
 
+/**
+ * Bounds-checked view over the `index`-th block of a destination buffer laid
+ * out as consecutive blocks of `BLOCK_SIZE` bytes; the view is truncated (or
+ * empty) where the buffer ends before the block does
+ */
+inline std::span<uint8_t> block_subspan(std::span<uint8_t> dest, int index) {
+  std::size_t block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  std::size_t offset = index * block_size;
+
+  if (offset >= dest.size())
+    return std::span<uint8_t>();
+
+  return dest.subspan(offset, std::min(block_size, dest.size() - offset));
+}
+
+/**
+ * Copies as much of `src` as fits into `dest`
+ */
+inline void copy_block(block_view src, std::span<uint8_t> dest) {
+  std::copy_n(src.begin(), std::min(src.size(), dest.size()), dest.begin());
+}
+
 /**
  * Resolves params (TIMESTAMP, BLOCK_SIZE, NUM_BLOCKS) from `stdin` or returns
  * default values when not informed.
@@ -115,6 +157,199 @@ inline program_args capture_args(int argc, const char **argv,
   }
 }
 
+/**
+ * Describes a runtime option, passed in as `--<name>=<value>`: the registry
+ * entry it is stored at, its default value and, for enumerated options, the
+ * integer each accepted value maps to (other options are parsed as integers,
+ * within `min_value` and `max_value`)
+ */
+struct OptionSpec {
+  GlobalRegistryIndex index;
+  int default_value;
+  std::map<std::string, int> choices;
+  int min_value = 0;
+  int max_value = std::numeric_limits<int>::max();
+};
+
+/**
+ * Runtime options accepted by the program, keyed by name
+ */
+inline const std::map<std::string, OptionSpec> &option_specs() {
+  static const std::map<std::string, OptionSpec> specs = {
+      {"backend",
+       {GlobalRegistryIndex::Backend,
+        DEFAULT_BACKEND,
+        {{"msg", BACKEND_MESSAGE}, {"rma", BACKEND_RMA}}}},
+      {"mode",
+       {GlobalRegistryIndex::Mode,
+        DEFAULT_MODE,
+        {{"run", MODE_RUN},
+         {"bench", MODE_BENCH},
+         {"workload", MODE_WORKLOAD}}}},
+      {"read-ratio",
+       {GlobalRegistryIndex::ReadRatio, DEFAULT_READ_RATIO, {}, 0, 100}},
+      {"op-blocks",
+       {GlobalRegistryIndex::OperationBlocks, DEFAULT_OPERATION_BLOCKS, {}, 1}},
+      {"key-dist",
+       {GlobalRegistryIndex::KeyDistribution,
+        DEFAULT_KEY_DIST,
+        {{"uniform", KEY_DIST_UNIFORM},
+         {"zipfian", KEY_DIST_ZIPFIAN},
+         {"sequential", KEY_DIST_SEQUENTIAL}}}},
+      {"threads",
+       {GlobalRegistryIndex::BenchThreads, DEFAULT_BENCH_THREADS, {}, 1}},
+      {"duration",
+       {GlobalRegistryIndex::DurationMillis, DEFAULT_DURATION_MILLIS, {}, 0}},
+      {"ops",
+       {GlobalRegistryIndex::OperationCount, DEFAULT_OPERATION_COUNT, {}, 0}},
+      {"coherence",
+       {GlobalRegistryIndex::Coherence,
+        DEFAULT_COHERENCE,
+        {{"broadcast", COHERENCE_BROADCAST},
+         {"directory", COHERENCE_DIRECTORY}}}},
+      {"write-mode",
+       {GlobalRegistryIndex::WriteMode,
+        DEFAULT_WRITE_MODE,
+        {{"through", WRITE_THROUGH}, {"back", WRITE_BACK}}}},
+      {"write-buffer-size",
+       {GlobalRegistryIndex::WriteBufferSize,
+        DEFAULT_WRITE_BUFFER_SIZE,
+        {},
+        1}},
+      {"write-buffer-window",
+       {GlobalRegistryIndex::WriteBufferWindowMicros,
+        DEFAULT_WRITE_BUFFER_WINDOW_MICROS,
+        {},
+        0}},
+      {"write-window",
+       {GlobalRegistryIndex::WriteWindow,
+        DEFAULT_WRITE_WINDOW,
+        {},
+        1}},
+      {"cache-size",
+       {GlobalRegistryIndex::CacheSize, DEFAULT_CACHE_SIZE, {}, 0}},
+      {"cache-policy",
+       {GlobalRegistryIndex::CachePolicy,
+        DEFAULT_CACHE_POLICY,
+        {{"clock", CACHE_POLICY_CLOCK}, {"lru", CACHE_POLICY_LRU}}}},
+      {"placement",
+       {GlobalRegistryIndex::Placement,
+        DEFAULT_PLACEMENT,
+        {{"cyclic", PLACEMENT_CYCLIC},
+         {"range", PLACEMENT_RANGE},
+         {"hash", PLACEMENT_HASH}}}},
+      {"placement-chunk",
+       {GlobalRegistryIndex::PlacementChunkSize,
+        DEFAULT_PLACEMENT_CHUNK_SIZE,
+        {},
+        1}},
+      {"migration-threshold",
+       {GlobalRegistryIndex::MigrationThreshold,
+        DEFAULT_MIGRATION_THRESHOLD,
+        {},
+        0}},
+      {"replicas",
+       {GlobalRegistryIndex::ReplicationFactor,
+        DEFAULT_REPLICATION_FACTOR,
+        {},
+        1}},
+      {"storage",
+       {GlobalRegistryIndex::Storage,
+        DEFAULT_STORAGE,
+        {{"heap", STORAGE_HEAP}, {"mmap", STORAGE_MMAP}}}},
+      {"restore",
+       {GlobalRegistryIndex::Restore, DEFAULT_RESTORE, {{"off", 0}, {"on", 1}}}},
+      {"checkpoint-every",
+       {GlobalRegistryIndex::CheckpointInterval,
+        DEFAULT_CHECKPOINT_INTERVAL,
+        {},
+        0}},
+      {"load",
+       {GlobalRegistryIndex::Load, DEFAULT_LOAD, {{"off", 0}, {"on", 1}}}},
+      {"dump-every",
+       {GlobalRegistryIndex::DumpInterval, DEFAULT_DUMP_INTERVAL, {}, 0}},
+      {"prefetch-depth",
+       {GlobalRegistryIndex::PrefetchDepth, DEFAULT_PREFETCH_DEPTH, {}, 0}},
+      {"batch-size",
+       {GlobalRegistryIndex::NotificationBatchSize,
+        DEFAULT_NOTIFICATION_BATCH_SIZE,
+        {},
+        1}},
+      {"batch-window",
+       {GlobalRegistryIndex::NotificationBatchWindowMicros,
+        DEFAULT_NOTIFICATION_BATCH_WINDOW_MICROS,
+        {},
+        0}},
+  };
+  return specs;
+}
+
+/**
+ * Whether `arg` is a runtime option (`--<name>=<value>`) rather than one of
+ * the positional params
+ */
+inline bool is_option_arg(const std::string &arg) {
+  return arg.starts_with("--");
+}
+
+/**
+ * Resolves runtime options (`--<name>=<value>`) from `stdin`, falling back to
+ * default values for those not informed.
+ *
+ * Exits with error status if an unknown option or invalid value is passed in.
+ */
+inline program_options capture_options(int argc, const char **argv,
+                                       bool verbose = false) {
+  auto fail = [&](const std::string &msg) {
+    if (verbose) {
+      std::cerr << "\033[31m" << msg << "\033[0m" << std::endl;
+    }
+    std::exit(EXIT_FAILURE);
+  };
+
+  program_options options;
+  for (const auto &[name, spec] : option_specs())
+    options[spec.index] = spec.default_value;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (!is_option_arg(arg))
+      continue;
+
+    std::size_t separator = arg.find('=');
+    std::string name = arg.substr(2, separator - 2);
+    auto it = option_specs().find(name);
+
+    if (separator == std::string::npos || it == option_specs().end())
+      fail(std::format("Opção inválida: {0}", arg));
+
+    std::string value = arg.substr(separator + 1);
+    const OptionSpec &spec = it->second;
+
+    if (spec.choices.empty()) {
+      try {
+        options[spec.index] = std::stoi(value);
+      } catch (const std::exception &e) {
+        fail(std::format("Valor inválido para a opção `{0}`: {1}", name,
+                         value));
+      }
+
+      if (options[spec.index] < spec.min_value)
+        fail(std::format("Valor da opção `{0}` deve ser maior ou igual a {1}",
+                         name, spec.min_value));
+      if (options[spec.index] > spec.max_value)
+        fail(std::format("Valor da opção `{0}` deve ser menor ou igual a {1}",
+                         name, spec.max_value));
+    } else if (spec.choices.contains(value)) {
+      options[spec.index] = spec.choices.at(value);
+    } else {
+      fail(std::format("Valor inválido para a opção `{0}`: {1}", name, value));
+    }
+  }
+
+  return options;
+}
+
 /**
  * Compute number of "worker" processes, that is, instances that act as memory
  * block maintainers and perform read/write operations
@@ -126,6 +361,95 @@ inline int get_num_worker_procs(int world_size) { return world_size - 1; }
  */
 inline int get_broadcaster_proc_rank(int world_size) { return world_size - 1; }
 
+/**
+ * Communicator dedicated to inbound requests (READ, WRITE, NOTIFICATION,
+ * INVALIDATION, FORWARDED READ/WRITE, REPLICA UPDATE, MIGRATION, OWNERSHIP and
+ * SHUTDOWN); duplicated from `MPI_COMM_WORLD` at startup so that the request
+ * dispatcher may probe for any tag without intercepting responses
+ */
+inline MPI_Comm &request_comm() {
+  static MPI_Comm comm = MPI_COMM_NULL;
+  return comm;
+}
+
+/**
+ * Communicator dedicated to the NOTIFICATION broadcast; duplicated from
+ * `MPI_COMM_WORLD` at startup, so that the non-blocking `MPI_Ibcast` ring
+ * progressed by the request dispatcher never matches the collectives issued by
+ * the main threads on the other communicators
+ */
+inline MPI_Comm &notification_comm() {
+  static MPI_Comm comm = MPI_COMM_NULL;
+  return comm;
+}
+
+/**
+ * Communicator spanning only the worker instances, split from
+ * `MPI_COMM_WORLD` at startup (`MPI_COMM_NULL` at the broadcaster); since
+ * workers are the lowest ranks, their rank in it matches their `world_rank`
+ */
+inline MPI_Comm &worker_comm() {
+  static MPI_Comm comm = MPI_COMM_NULL;
+  return comm;
+}
+
+/**
+ * Communicator dedicated to the reductions of the shutdown protocol (see
+ * `ShutdownProtocol`), run by the request dispatchers while the main threads
+ * may still synchronize over the other communicators; duplicated from
+ * `MPI_COMM_WORLD` at startup
+ */
+inline MPI_Comm &shutdown_comm() {
+  static MPI_Comm comm = MPI_COMM_NULL;
+  return comm;
+}
+
+/**
+ * Resolves the handler shard for an inbound request; requests targeting the
+ * same (first) block always land on the same handler thread, preserving their
+ * order. INVALIDATION and REPLICA UPDATE payloads begin with an `int` count
+ * followed by the key of the first targeted block, READ and WRITE payloads
+ * prepend an `int` request ID or sequence number to that, FORWARDED READ and
+ * WRITE payloads further prepend the `int` origin, and NOTIFICATION, MIGRATION
+ * and OWNERSHIP payloads begin with the key itself
+ */
+inline int get_request_shard(const Request &request) {
+  int offset;
+  switch (request.tag) {
+  case MESSAGE_TAG_BLOCK_FORWARDED_READ:
+  case MESSAGE_TAG_BLOCK_FORWARDED_WRITE:
+    offset = 3 * sizeof(int);
+    break;
+  case MESSAGE_TAG_BLOCK_READ_REQUEST:
+  case MESSAGE_TAG_BLOCK_WRITE_REQUEST:
+    offset = 2 * sizeof(int);
+    break;
+  case MESSAGE_TAG_BLOCK_INVALIDATION:
+  case MESSAGE_TAG_BLOCK_REPLICA_UPDATE:
+    offset = sizeof(int);
+    break;
+  default:
+    offset = 0;
+  }
+  int key = 0;
+
+  if (request.size >= offset + static_cast<int>(sizeof(int)))
+    std::memcpy(&key, request.payload.get() + offset, sizeof(int));
+
+  return key;
+}
+
+/**
+ * Whether an inbound request is handled by the request dispatcher itself,
+ * before it receives any further request: MIGRATION and OWNERSHIP requests
+ * change the maintainer of a block, which the requests received after them
+ * from the same process rely on
+ */
+inline bool is_dispatcher_request(const Request &request) {
+  return request.tag == MESSAGE_TAG_BLOCK_MIGRATION ||
+         request.tag == MESSAGE_TAG_BLOCK_OWNERSHIP;
+}
+
 /**
  * Validates parameters interpreted from `stdin` according to application
  * logic.
@@ -183,6 +507,19 @@ inline bool is_verbose(int world_rank) {
   return world_rank == MASTER_INSTANCE_ID;
 }
 
+/**
+ * Provides the block placement strategy selected by the `Placement` option,
+ * built on first use
+ */
+inline const PlacementStrategy &placement() {
+  static const std::unique_ptr<PlacementStrategy> strategy = make_placement(
+      registry_get(GlobalRegistryIndex::Placement),
+      get_num_worker_procs(registry_get(GlobalRegistryIndex::WorldSize)),
+      registry_get(GlobalRegistryIndex::NumBlocks),
+      registry_get(GlobalRegistryIndex::PlacementChunkSize));
+  return *strategy;
+}
+
 /**
  * Resolves the `memory_map` representing the memory block distribution
  * between the program instances
@@ -194,101 +531,581 @@ inline memory_map resolve_maintainers() {
 
   std::vector<std::vector<int>> assignment(world_size);
   for (int i = 0; i < num_blocks; ++i) {
-    assignment[i % world_size].push_back(i);
+    assignment[placement().maintainer_of(i)].push_back(i);
   }
 
   return assignment;
 }
 
+/**
+ * Maintainer of every block, as currently known by this process: blocks start
+ * out where the placement strategy puts them, and are updated as they migrate
+ */
+inline std::vector<std::atomic<int>> &maintainers() {
+  static std::vector<std::atomic<int>> table = [] {
+    std::vector<std::atomic<int>> table(
+        registry_get(GlobalRegistryIndex::NumBlocks));
+    for (size_t i = 0; i < table.size(); i++)
+      table[i].store(placement().maintainer_of(i), std::memory_order_relaxed);
+    return table;
+  }();
+  return table;
+}
+
 /**
  * Resolves the maintainer process' ID based on the desired block
  */
 inline int resolve_maintainer(int key) {
-  return key %
-         get_num_worker_procs(registry_get(GlobalRegistryIndex::WorldSize));
+  return maintainers().at(key).load(std::memory_order_acquire);
 }
 
 /**
- * Calculates the total size (in bytes) of a WRITE message buffer, considering
- * the following buffer layout:
+ * Records process `maintainer` as maintaining block indexed by `key`
+ */
+inline void set_maintainer(int key, int maintainer) {
+  maintainers().at(key).store(maintainer, std::memory_order_release);
+}
+
+/**
+ * Whether blocks migrate to the workers dominating their traffic; only the
+ * message-based backend in write-through mode supports it
+ */
+inline bool is_migration_enabled() {
+  return registry_get(GlobalRegistryIndex::MigrationThreshold) > 0 &&
+         registry_get(GlobalRegistryIndex::Backend) == BACKEND_MESSAGE &&
+         registry_get(GlobalRegistryIndex::WriteMode) == WRITE_THROUGH;
+}
+
+/**
+ * Whether blocks are kept in `ReplicationFactor` copies; only the
+ * message-based backend supports it, and only while blocks never migrate,
+ * since replicas are placed relative to their maintainer
+ */
+inline bool is_replication_enabled() {
+  return registry_get(GlobalRegistryIndex::ReplicationFactor) > 1 &&
+         registry_get(GlobalRegistryIndex::Backend) == BACKEND_MESSAGE &&
+         !is_migration_enabled();
+}
+
+/**
+ * Resolves the processes holding a copy of block indexed by `key`: its
+ * maintainer (the primary copy, always first), followed by the workers ranked
+ * right after it, which hold its read replicas (up to `ReplicationFactor`
+ * copies in total, one per worker)
+ */
+inline std::vector<int> resolve_replicas(int key) {
+  int maintainer = resolve_maintainer(key);
+  if (!is_replication_enabled())
+    return {maintainer};
+
+  int num_workers =
+      get_num_worker_procs(registry_get(GlobalRegistryIndex::WorldSize));
+  int copies = std::min(registry_get(GlobalRegistryIndex::ReplicationFactor),
+                        num_workers);
+
+  std::vector<int> replicas;
+  for (int i = 0; i < copies; i++)
+    replicas.push_back((maintainer + i) % num_workers);
+  return replicas;
+}
+
+/**
+ * Whether the blocks maintained by every worker are kept in a memory-mapped
+ * file under `STORAGE_DIR`; only the message-based backend supports it, since
+ * the RMA backend exposes its blocks through an MPI window
+ */
+inline bool is_persistence_enabled() {
+  return registry_get(GlobalRegistryIndex::Storage) == STORAGE_MMAP &&
+         registry_get(GlobalRegistryIndex::Backend) == BACKEND_MESSAGE;
+}
+
+/**
+ * Whether workers start from the blocks persisted by the last checkpoint
+ */
+inline bool is_restore_enabled() {
+  return is_persistence_enabled() &&
+         registry_get(GlobalRegistryIndex::Restore) != 0;
+}
+
+/**
+ * Path of the file holding the blocks of process `world_rank` (along with the
+ * manifest of its last checkpoint, at the same path suffixed with `.meta`)
+ */
+inline std::string get_storage_path(int world_rank) {
+  return std::format("{0}/proc-{1}.slab", STORAGE_DIR, world_rank);
+}
+
+/**
+ * Whether process `rank` holds a read replica of block indexed by `key`
+ * (without maintaining it)
+ */
+inline bool is_replica_holder(int key, int rank) {
+  std::vector<int> replicas = resolve_replicas(key);
+  return std::find(replicas.begin() + 1, replicas.end(), rank) !=
+         replicas.end();
+}
+
+// clang-format off
+
+/**
+ * Calculates the total size (in bytes) of a READ message buffer targeting
+ * `count` blocks, considering the following buffer layout:
  *
- * `[ int target_index {sizeof(int) bytes} ][ block data {BLOCK_SIZE bytes} ]`
+ * `[ int request_id ][ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version cached_version ] * count`
  */
-inline int get_total_write_message_buffer_size() {
-  return sizeof(int) + registry_get(GlobalRegistryIndex::BlockSize);
+inline int get_total_read_message_buffer_size(int count) {
+  // clang-format on
+  return 2 * sizeof(int) + count * (sizeof(int) + sizeof(block_version));
 }
 
 // clang-format off
 
 /**
- * Calculates the total size (in bytes) of a NOTIFICATION message buffer,
- * considering the following buffer layout:
+ * Calculates the maximum size (in bytes) of the response to a READ message
+ * targeting `count` blocks, considering the following buffer layout, wherein
+ * the data of blocks still at the version cached by the requester is omitted:
  *
- * `[ int target_index {sizeof(int) bytes} ][ long timestamp {sizeof(long) bytes} ]`
+ * `[ int request_id ]([ block_version version ][ block data {BLOCK_SIZE bytes, if modified} ]) * count`
  */
-inline int get_total_notification_message_buffer_size() {
+inline int get_total_read_response_buffer_size(int count) {
+  // clang-format on
+  return sizeof(int) +
+         count * (sizeof(block_version) +
+                  registry_get(GlobalRegistryIndex::BlockSize));
+}
+
+/**
+ * Resolves the tag of the response to the READ request identified by
+ * `request_id`
+ */
+inline int get_read_response_tag(int request_id) {
+  return MESSAGE_TAG_BLOCK_READ_RESPONSE_BASE +
+         request_id % READ_REQUEST_ID_SPAN;
+}
+
+/**
+ * Resolves the tag of the acknowledgement to the WRITE request identified by
+ * `sequence`
+ */
+inline int get_write_ack_tag(int sequence) {
+  return MESSAGE_TAG_BLOCK_WRITE_ACK_BASE + sequence % WRITE_SEQUENCE_SPAN;
+}
+
+// clang-format off
+
+/**
+ * Calculates the total size (in bytes) of a WRITE message buffer carrying
+ * `entries`, considering the following buffer layout:
+ *
+ * `[ int sequence ][ int count ]([ int target_index ][ int offset ][ int length ][ data {length bytes} ]) * count`
+ */
+inline int get_total_write_message_buffer_size(
+    const std::vector<WriteMessageBuffer> &entries) {
   // clang-format on
-  return sizeof(int) + sizeof(long);
+  int total_size = 2 * sizeof(int);
+  for (const WriteMessageBuffer &entry : entries)
+    total_size += 3 * sizeof(int) + entry.length;
+  return total_size;
 }
 
 /**
- * Encodes a WRITE message from `WriteMessageBuffer` to the buffer layout:
+ * Whether `entry` targets a non-empty byte range lying within its block
+ */
+inline bool is_valid_write_range(const WriteMessageBuffer &entry) {
+  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  return entry.offset >= 0 && entry.length > 0 &&
+         entry.offset + entry.length <= block_size;
+}
+
+/**
+ * Reads the `int` count header found at `offset` of the READ, WRITE and
+ * NOTIFICATION batch buffer layouts
+ */
+inline int decode_message_count(std::shared_ptr<uint8_t[]> message_buffer,
+                                int offset = 0) {
+  int count;
+  std::memcpy(&count, message_buffer.get() + offset, sizeof(int));
+  return count;
+}
+
+// clang-format off
+
+/**
+ * Encodes a READ message from `ReadMessageBuffer` to the buffer layout:
  *
- * `[ int target_index {sizeof(int) bytes} ][ block data {BLOCK_SIZE bytes} ]`
+ * `[ int request_id ][ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version cached_version ] * count`
  */
 inline std::shared_ptr<uint8_t[]>
-encode_write_message(WriteMessageBuffer &message) {
-  int total_size = get_total_write_message_buffer_size();
-  int key = message.key;
-  block value = message.data;
+encode_read_message(const ReadMessageBuffer &message) {
+  // clang-format on
+  int count = message.keys.size();
+  std::shared_ptr<uint8_t[]> message_buffer =
+      std::make_shared<uint8_t[]>(get_total_read_message_buffer_size(count));
+
+  std::memcpy(message_buffer.get(), &message.request_id, sizeof(int));
+  std::memcpy(message_buffer.get() + sizeof(int), &count, sizeof(int));
+  std::memcpy(message_buffer.get() + 2 * sizeof(int), message.keys.data(),
+              count * sizeof(int));
+  std::memcpy(message_buffer.get() + (2 + count) * sizeof(int),
+              message.versions.data(), count * sizeof(block_version));
+
+  return message_buffer;
+}
+
+// clang-format off
+
+/**
+ * Decodes a READ message to `ReadMessageBuffer`, from the buffer layout:
+ *
+ * `[ int request_id ][ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version cached_version ] * count`
+ */
+inline ReadMessageBuffer
+decode_read_message(std::shared_ptr<uint8_t[]> message_buffer) {
+  // clang-format on
+  int request_id;
+  int count = decode_message_count(message_buffer, sizeof(int));
+  std::vector<int> keys(count);
+  std::vector<block_version> versions(count);
+
+  std::memcpy(&request_id, message_buffer.get(), sizeof(int));
+  std::memcpy(keys.data(), message_buffer.get() + 2 * sizeof(int),
+              count * sizeof(int));
+  std::memcpy(versions.data(), message_buffer.get() + (2 + count) * sizeof(int),
+              count * sizeof(block_version));
+
+  thread_safe_log_with_id(
+      std::format("Decoded read message of request ID {0} targeting blocks {1} "
+                  "cached at versions {2}",
+                  request_id, print_vec(keys), print_vec(versions)));
+
+  return ReadMessageBuffer(request_id, keys, versions);
+}
+
+// clang-format off
+
+/**
+ * Encodes a WRITE message from a list of `WriteMessageBuffer` to the buffer
+ * layout, carrying only the written byte range of each block:
+ *
+ * `[ int sequence ][ int count ]([ int target_index ][ int offset ][ int length ][ data {length bytes} ]) * count`
+ */
+inline std::shared_ptr<uint8_t[]>
+encode_write_message(int sequence,
+                     const std::vector<WriteMessageBuffer> &messages) {
+  // clang-format on
+  int count = messages.size();
+  int total_size = get_total_write_message_buffer_size(messages);
 
   std::shared_ptr<uint8_t[]> message_buffer =
       std::make_shared<uint8_t[]>(total_size);
 
-  std::memcpy(message_buffer.get(), &key, sizeof(int));
-  std::memcpy(message_buffer.get() + sizeof(int), value.get(),
-              registry_get(GlobalRegistryIndex::BlockSize));
+  std::memcpy(message_buffer.get(), &sequence, sizeof(int));
+  std::memcpy(message_buffer.get() + sizeof(int), &count, sizeof(int));
+  uint8_t *cursor = message_buffer.get() + 2 * sizeof(int);
+
+  for (const WriteMessageBuffer &message : messages) {
+    std::memcpy(cursor, &message.key, sizeof(int));
+    std::memcpy(cursor + sizeof(int), &message.offset, sizeof(int));
+    std::memcpy(cursor + 2 * sizeof(int), &message.length, sizeof(int));
+    std::memcpy(cursor + 3 * sizeof(int), message.data.get(), message.length);
+    cursor += 3 * sizeof(int) + message.length;
+
+    thread_safe_log_with_id(std::format(
+        "Encoding write message entry of key: {0}, offset: {1}, value: {2}",
+        message.key, message.offset,
+        print_block(message.data, message.length)));
+  }
 
-  thread_safe_log_with_id(std::format("Encoding write message from of key: "
-                                      "{0}, value: {1} as bytearray buffer {2}",
-                                      message.key, print_block(message.data),
-                                      print_block(message_buffer, total_size)));
+  thread_safe_log_with_id(
+      std::format("Encoded {0} write message entries as bytearray buffer {1}",
+                  count, print_block(message_buffer, total_size)));
 
   return message_buffer;
 }
 
+// clang-format off
+
 /**
- * Decodes a WRITE message to `WriteMessageBuffer`, from  the buffer layout:
+ * Decodes a WRITE message of `size` bytes to a list of `WriteMessageBuffer`,
+ * from the buffer layout:
+ *
+ * `[ int sequence ][ int count ]([ int target_index ][ int offset ][ int length ][ data {length bytes} ]) * count`
  *
- * `[ int target_index {sizeof(int) bytes} ][ block data {BLOCK_SIZE bytes} ]`
+ * Throws if the entries do not add up to `size` bytes or any of them targets
+ * a byte range outside of its block
  */
-inline WriteMessageBuffer
-decode_write_message(std::shared_ptr<uint8_t[]> message_buffer) {
-  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
-  int total_size = get_total_write_message_buffer_size();
+inline std::vector<WriteMessageBuffer>
+decode_write_message(std::shared_ptr<uint8_t[]> message_buffer, int size) {
+  // clang-format on
+  int count = decode_message_count(message_buffer, sizeof(int));
 
   thread_safe_log_with_id(
       std::format("Decoding write message from bytearray buffer: {0}",
-                  print_block(message_buffer, total_size)));
+                  print_block(message_buffer, size)));
+
+  std::vector<WriteMessageBuffer> result;
+  const uint8_t *cursor = message_buffer.get() + 2 * sizeof(int);
+  const uint8_t *end = message_buffer.get() + size;
+
+  for (int i = 0; i < count; i++) {
+    if (end - cursor < static_cast<std::ptrdiff_t>(3 * sizeof(int)))
+      throw std::runtime_error("Malformed WRITE message");
+
+    WriteMessageBuffer entry;
+    std::memcpy(&entry.key, cursor, sizeof(int));
+    std::memcpy(&entry.offset, cursor + sizeof(int), sizeof(int));
+    std::memcpy(&entry.length, cursor + 2 * sizeof(int), sizeof(int));
+    cursor += 3 * sizeof(int);
+
+    if (!is_valid_write_range(entry) || end - cursor < entry.length)
+      throw std::runtime_error("Malformed WRITE message");
+
+    entry.data = std::make_shared<uint8_t[]>(entry.length);
+    std::memcpy(entry.data.get(), cursor, entry.length);
+    cursor += entry.length;
+
+    thread_safe_log_with_id(
+        std::format("Constructed object: key {0}, offset {1}, value {2}",
+                    entry.key, entry.offset,
+                    print_block(entry.data, entry.length)));
+    result.push_back(entry);
+  }
 
-  int key;
-  block value = std::make_shared<uint8_t[]>(block_size);
+  if (cursor != end)
+    throw std::runtime_error("Malformed WRITE message");
 
-  thread_safe_log_with_id("Allocated memory for buffer");
+  return result;
+}
 
-  std::memcpy(&key, message_buffer.get(), sizeof(int));
-  std::memcpy(value.get(), message_buffer.get() + sizeof(int), block_size);
+// clang-format off
 
-  thread_safe_log_with_id("Copied buffer to memory");
+/**
+ * Calculates the total size (in bytes) of a FORWARDED READ message buffer
+ * targeting `count` blocks, considering the following buffer layout, wherein
+ * the READ message is laid out as in `get_total_read_message_buffer_size`:
+ *
+ * `[ int origin ][ READ message ][ block_version version ] * count [ block data {BLOCK_SIZE bytes} ] * count`
+ */
+inline int get_total_forwarded_read_message_buffer_size(int count) {
+  // clang-format on
+  return sizeof(int) + get_total_read_message_buffer_size(count) +
+         count * (sizeof(block_version) +
+                  registry_get(GlobalRegistryIndex::BlockSize));
+}
 
-  WriteMessageBuffer result(key, value);
+// clang-format off
 
-  thread_safe_log_with_id(std::format(
-      "Constructed object: key {0}, value {1} from raw message buffer {2}",
-      result.key, print_block(result.data),
-      print_block(message_buffer, total_size)));
+/**
+ * Encodes a FORWARDED READ message from `ForwardedReadMessageBuffer` to the
+ * buffer layout:
+ *
+ * `[ int origin ][ READ message ][ block_version version ] * count [ block data {BLOCK_SIZE bytes} ] * count`
+ */
+inline std::shared_ptr<uint8_t[]>
+encode_forwarded_read_message(const ForwardedReadMessageBuffer &message) {
+  // clang-format on
+  int count = message.request.keys.size();
+  int read_size = get_total_read_message_buffer_size(count);
+  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  std::shared_ptr<uint8_t[]> message_buffer = std::make_shared<uint8_t[]>(
+      get_total_forwarded_read_message_buffer_size(count));
+
+  uint8_t *cursor = message_buffer.get();
+  std::memcpy(cursor, &message.origin, sizeof(int));
+  cursor += sizeof(int);
+  std::memcpy(cursor, encode_read_message(message.request).get(), read_size);
+  cursor += read_size;
+  std::memcpy(cursor, message.versions.data(), count * sizeof(block_version));
+  cursor += count * sizeof(block_version);
+  std::memcpy(cursor, message.contents.get(), count * block_size);
 
-  return result;
+  return message_buffer;
+}
+
+// clang-format off
+
+/**
+ * Decodes a FORWARDED READ message to `ForwardedReadMessageBuffer`, from the
+ * buffer layout:
+ *
+ * `[ int origin ][ READ message ][ block_version version ] * count [ block data {BLOCK_SIZE bytes} ] * count`
+ */
+inline ForwardedReadMessageBuffer
+decode_forwarded_read_message(std::shared_ptr<uint8_t[]> message_buffer) {
+  // clang-format on
+  ForwardedReadMessageBuffer message;
+  std::memcpy(&message.origin, message_buffer.get(), sizeof(int));
+  message.request = decode_read_message(std::shared_ptr<uint8_t[]>(
+      message_buffer, message_buffer.get() + sizeof(int)));
+
+  int count = message.request.keys.size();
+  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  const uint8_t *cursor = message_buffer.get() + sizeof(int) +
+                          get_total_read_message_buffer_size(count);
+
+  message.versions.resize(count);
+  std::memcpy(message.versions.data(), cursor, count * sizeof(block_version));
+  cursor += count * sizeof(block_version);
+  message.contents = std::make_shared<uint8_t[]>(count * block_size);
+  std::memcpy(message.contents.get(), cursor, count * block_size);
+
+  return message;
+}
+
+// clang-format off
+
+/**
+ * Encodes a FORWARDED WRITE message, carrying the WRITE message of process
+ * `origin` (laid out as in `encode_write_message`), to the buffer layout:
+ *
+ * `[ int origin ][ WRITE message ]`
+ */
+inline std::shared_ptr<uint8_t[]>
+encode_forwarded_write_message(int origin, int sequence,
+                               const std::vector<WriteMessageBuffer> &entries) {
+  // clang-format on
+  int write_size = get_total_write_message_buffer_size(entries);
+  std::shared_ptr<uint8_t[]> message_buffer =
+      std::make_shared<uint8_t[]>(sizeof(int) + write_size);
+
+  std::memcpy(message_buffer.get(), &origin, sizeof(int));
+  std::memcpy(message_buffer.get() + sizeof(int),
+              encode_write_message(sequence, entries).get(), write_size);
+
+  return message_buffer;
+}
+
+// clang-format off
+
+/**
+ * Calculates the total size (in bytes) of a MIGRATION message buffer,
+ * considering the following buffer layout:
+ *
+ * `[ int target_index ][ int epoch ][ block_version version ][ block data {BLOCK_SIZE bytes} ]`
+ */
+inline int get_total_migration_message_buffer_size() {
+  // clang-format on
+  return 2 * sizeof(int) + sizeof(block_version) +
+         registry_get(GlobalRegistryIndex::BlockSize);
+}
+
+// clang-format off
+
+/**
+ * Encodes a MIGRATION message from `MigrationMessageBuffer` to the buffer
+ * layout:
+ *
+ * `[ int target_index ][ int epoch ][ block_version version ][ block data {BLOCK_SIZE bytes} ]`
+ */
+inline std::shared_ptr<uint8_t[]>
+encode_migration_message(const MigrationMessageBuffer &message) {
+  // clang-format on
+  std::shared_ptr<uint8_t[]> message_buffer = std::make_shared<uint8_t[]>(
+      get_total_migration_message_buffer_size());
+
+  std::memcpy(message_buffer.get(), &message.key, sizeof(int));
+  std::memcpy(message_buffer.get() + sizeof(int), &message.epoch, sizeof(int));
+  std::memcpy(message_buffer.get() + 2 * sizeof(int), &message.version,
+              sizeof(block_version));
+  std::memcpy(message_buffer.get() + 2 * sizeof(int) + sizeof(block_version),
+              message.data.get(), registry_get(GlobalRegistryIndex::BlockSize));
+
+  return message_buffer;
+}
+
+// clang-format off
+
+/**
+ * Decodes a MIGRATION message to `MigrationMessageBuffer`, from the buffer
+ * layout:
+ *
+ * `[ int target_index ][ int epoch ][ block_version version ][ block data {BLOCK_SIZE bytes} ]`
+ */
+inline MigrationMessageBuffer
+decode_migration_message(std::shared_ptr<uint8_t[]> message_buffer) {
+  // clang-format on
+  int block_size = registry_get(GlobalRegistryIndex::BlockSize);
+  MigrationMessageBuffer message;
+
+  std::memcpy(&message.key, message_buffer.get(), sizeof(int));
+  std::memcpy(&message.epoch, message_buffer.get() + sizeof(int), sizeof(int));
+  std::memcpy(&message.version, message_buffer.get() + 2 * sizeof(int),
+              sizeof(block_version));
+  message.data = std::make_shared<uint8_t[]>(block_size);
+  std::memcpy(message.data.get(),
+              message_buffer.get() + 2 * sizeof(int) + sizeof(block_version),
+              block_size);
+
+  return message;
+}
+
+// clang-format off
+
+/**
+ * Calculates the total size (in bytes) of an OWNERSHIP message buffer,
+ * considering the following buffer layout:
+ *
+ * `[ int target_index ][ int epoch ][ int maintainer ]`
+ */
+inline int get_total_ownership_message_buffer_size() {
+  // clang-format on
+  return 3 * sizeof(int);
+}
+
+// clang-format off
+
+/**
+ * Encodes an OWNERSHIP message from `OwnershipMessageBuffer` to the buffer
+ * layout:
+ *
+ * `[ int target_index ][ int epoch ][ int maintainer ]`
+ */
+inline std::shared_ptr<uint8_t[]>
+encode_ownership_message(const OwnershipMessageBuffer &message) {
+  // clang-format on
+  std::shared_ptr<uint8_t[]> message_buffer = std::make_shared<uint8_t[]>(
+      get_total_ownership_message_buffer_size());
+
+  std::memcpy(message_buffer.get(), &message.key, sizeof(int));
+  std::memcpy(message_buffer.get() + sizeof(int), &message.epoch, sizeof(int));
+  std::memcpy(message_buffer.get() + 2 * sizeof(int), &message.maintainer,
+              sizeof(int));
+
+  return message_buffer;
+}
+
+// clang-format off
+
+/**
+ * Decodes an OWNERSHIP message to `OwnershipMessageBuffer`, from the buffer
+ * layout:
+ *
+ * `[ int target_index ][ int epoch ][ int maintainer ]`
+ */
+inline OwnershipMessageBuffer
+decode_ownership_message(std::shared_ptr<uint8_t[]> message_buffer) {
+  // clang-format on
+  OwnershipMessageBuffer message;
+
+  std::memcpy(&message.key, message_buffer.get(), sizeof(int));
+  std::memcpy(&message.epoch, message_buffer.get() + sizeof(int), sizeof(int));
+  std::memcpy(&message.maintainer, message_buffer.get() + 2 * sizeof(int),
+              sizeof(int));
+
+  return message;
+}
+
+// clang-format off
+
+/**
+ * Calculates the total size (in bytes) of a NOTIFICATION message buffer,
+ * considering the following buffer layout:
+ *
+ * `[ int target_index {sizeof(int) bytes} ][ block_version version ][ long timestamp {sizeof(long) bytes} ]`
+ */
+inline int get_total_notification_message_buffer_size() {
+  // clang-format on
+  return sizeof(int) + sizeof(block_version) + sizeof(long);
 }
 
 // clang-format off
@@ -297,7 +1114,7 @@ decode_write_message(std::shared_ptr<uint8_t[]> message_buffer) {
  * Encodes a NOTIFICATION message from `NotificationMessageBuffer` to the
  * buffer layout:
  *
- * `[ int target_index {sizeof(int) bytes} ][ long timestamp {sizeof(long) bytes} ]`
+ * `[ int target_index {sizeof(int) bytes} ][ block_version version ][ long timestamp {sizeof(long) bytes} ]`
  */
 inline std::shared_ptr<uint8_t[]>
 encode_notification_message(NotificationMessageBuffer &message) {
@@ -310,12 +1127,16 @@ encode_notification_message(NotificationMessageBuffer &message) {
       std::make_shared<uint8_t[]>(total_size);
 
   std::memcpy(message_buffer.get(), &key, sizeof(int));
-  std::memcpy(message_buffer.get() + sizeof(int), &timestamp, sizeof(long));
+  std::memcpy(message_buffer.get() + sizeof(int), &message.version,
+              sizeof(block_version));
+  std::memcpy(message_buffer.get() + sizeof(int) + sizeof(block_version),
+              &timestamp, sizeof(long));
 
   thread_safe_log_with_id(std::format(
       "Encoding notification message from of key: "
-      "{0}, timestamp: {1} as bytearray buffer {2}",
-      message.key, timestamp, print_block(message_buffer, total_size)));
+      "{0}, version: {1}, timestamp: {2} as bytearray buffer {3}",
+      message.key, message.version, timestamp,
+      print_block(message_buffer, total_size)));
 
   return message_buffer;
 }
@@ -325,7 +1146,7 @@ encode_notification_message(NotificationMessageBuffer &message) {
 /**
  * Decodes a NOTIFICATION message to `NotificationMessageBuffer`, from  the buffer layout:
  *
- * `[ int target_index {sizeof(int) bytes} ][ long timestamp {sizeof(long) bytes} ]`
+ * `[ int target_index {sizeof(int) bytes} ][ block_version version ][ long timestamp {sizeof(long) bytes} ]`
  */
 inline NotificationMessageBuffer
 decode_notificaton_message(std::shared_ptr<uint8_t[]> message_buffer) {
@@ -337,25 +1158,159 @@ decode_notificaton_message(std::shared_ptr<uint8_t[]> message_buffer) {
                   print_block(message_buffer, total_size)));
 
   int key;
+  block_version version;
   long timestamp;
 
   thread_safe_log_with_id("Allocated memory for buffer");
 
   std::memcpy(&key, message_buffer.get(), sizeof(int));
-  std::memcpy(&timestamp, message_buffer.get() + sizeof(int), sizeof(long));
+  std::memcpy(&version, message_buffer.get() + sizeof(int),
+              sizeof(block_version));
+  std::memcpy(&timestamp,
+              message_buffer.get() + sizeof(int) + sizeof(block_version),
+              sizeof(long));
 
   thread_safe_log_with_id("Copied buffer to memory");
 
-  NotificationMessageBuffer result(key, timestamp);
+  NotificationMessageBuffer result(key, version, timestamp);
 
   thread_safe_log_with_id(std::format(
-      "Constructed object: key {0}, timestamp {1} from "
-      "raw message buffer {2}",
-      result.key, timestamp, print_block(message_buffer, total_size)));
+      "Constructed object: key {0}, version {1}, timestamp {2} from "
+      "raw message buffer {3}",
+      result.key, version, timestamp, print_block(message_buffer, total_size)));
 
   return result;
 }
 
+// clang-format off
+
+/**
+ * Calculates the total size (in bytes) of a NOTIFICATION batch broadcast
+ * buffer, holding up to `capacity` keys (INVALIDATION messages share this
+ * layout, sized to their own keys), considering the following buffer layout:
+ *
+ * `[ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version version ] * count`
+ */
+inline int get_total_notification_batch_buffer_size(int capacity) {
+  // clang-format on
+  return sizeof(int) + capacity * (sizeof(int) + sizeof(block_version));
+}
+
+// clang-format off
+
+/**
+ * Encodes `batch` to a buffer holding up to `capacity` keys, with the layout:
+ *
+ * `[ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version version ] * count`
+ */
+inline std::shared_ptr<uint8_t[]>
+encode_notification_batch(const NotificationBatch &batch, int capacity) {
+  // clang-format on
+  if (static_cast<int>(batch.keys.size()) > capacity)
+    throw std::runtime_error("NOTIFICATION batch exceeds buffer capacity");
+
+  int count = batch.keys.size();
+  std::shared_ptr<uint8_t[]> message_buffer = std::make_shared<uint8_t[]>(
+      get_total_notification_batch_buffer_size(capacity));
+
+  std::memcpy(message_buffer.get(), &count, sizeof(int));
+  std::memcpy(message_buffer.get() + sizeof(int), batch.keys.data(),
+              count * sizeof(int));
+  std::memcpy(message_buffer.get() + (1 + count) * sizeof(int),
+              batch.versions.data(), count * sizeof(block_version));
+
+  return message_buffer;
+}
+
+// clang-format off
+
+/**
+ * Decodes a NOTIFICATION batch from the buffer layout:
+ *
+ * `[ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version version ] * count`
+ */
+inline NotificationBatch
+decode_notification_batch(std::shared_ptr<uint8_t[]> message_buffer) {
+  // clang-format on
+  int count = decode_message_count(message_buffer);
+  NotificationBatch batch{std::vector<int>(count),
+                          std::vector<block_version>(count)};
+
+  std::memcpy(batch.keys.data(), message_buffer.get() + sizeof(int),
+              count * sizeof(int));
+  std::memcpy(batch.versions.data(),
+              message_buffer.get() + (1 + count) * sizeof(int),
+              count * sizeof(block_version));
+
+  return batch;
+}
+
+// clang-format off
+
+/**
+ * Calculates the total size (in bytes) of a REPLICA UPDATE message buffer
+ * carrying `count` blocks, considering the following buffer layout, wherein the
+ * keys and versions are laid out as in an INVALIDATION message:
+ *
+ * `[ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version version ] * count [ block data {BLOCK_SIZE bytes} ] * count`
+ */
+inline int get_total_replica_update_buffer_size(int count) {
+  // clang-format on
+  return get_total_notification_batch_buffer_size(count) +
+         count * registry_get(GlobalRegistryIndex::BlockSize);
+}
+
+// clang-format off
+
+/**
+ * Encodes `batch` to the buffer layout:
+ *
+ * `[ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version version ] * count [ block data {BLOCK_SIZE bytes} ] * count`
+ */
+inline std::shared_ptr<uint8_t[]>
+encode_replica_update(const ReplicaUpdateBatch &batch) {
+  // clang-format on
+  int count = batch.keys.size();
+  int header_size = get_total_notification_batch_buffer_size(count);
+  std::shared_ptr<uint8_t[]> message_buffer =
+      std::make_shared<uint8_t[]>(get_total_replica_update_buffer_size(count));
+
+  std::memcpy(
+      message_buffer.get(),
+      encode_notification_batch(NotificationBatch{batch.keys, batch.versions},
+                                count)
+          .get(),
+      header_size);
+  std::memcpy(message_buffer.get() + header_size, batch.contents.get(),
+              count * registry_get(GlobalRegistryIndex::BlockSize));
+
+  return message_buffer;
+}
+
+// clang-format off
+
+/**
+ * Decodes a REPLICA UPDATE message from the buffer layout:
+ *
+ * `[ int count ][ int target_index {sizeof(int) bytes} ] * count [ block_version version ] * count [ block data {BLOCK_SIZE bytes} ] * count`
+ */
+inline ReplicaUpdateBatch
+decode_replica_update(std::shared_ptr<uint8_t[]> message_buffer) {
+  // clang-format on
+  NotificationBatch header = decode_notification_batch(message_buffer);
+  int count = header.keys.size();
+  int data_size = count * registry_get(GlobalRegistryIndex::BlockSize);
+  ReplicaUpdateBatch batch{header.keys, header.versions,
+                           std::make_shared<uint8_t[]>(data_size)};
+
+  std::memcpy(batch.contents.get(),
+              message_buffer.get() +
+                  get_total_notification_batch_buffer_size(count),
+              data_size);
+
+  return batch;
+}
+
 inline block get_random_block() {
   int block_size = registry_get(GlobalRegistryIndex::BlockSize);
   block buffer = std::make_shared<uint8_t[]>(block_size);
@@ -0,0 +1,115 @@
+#include "workload.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+
+UniformKeyGenerator::UniformKeyGenerator(int positions, uint32_t seed)
+    : rng(seed), distribution(0, positions - 1) {}
+
+int UniformKeyGenerator::next() { return distribution(rng); }
+
+ZipfianKeyGenerator::ZipfianKeyGenerator(int positions, double theta,
+                                         uint32_t seed)
+    : rng(seed), distribution(0.0, 1.0), positions(positions), theta(theta),
+      zeta(0), alpha(1 / (1 - theta)) {
+  for (int i = 1; i <= positions; i++)
+    zeta += 1 / std::pow(i, theta);
+
+  double zeta2 = 1 + 1 / std::pow(2, theta);
+  eta = (1 - std::pow(2.0 / positions, 1 - theta)) / (1 - zeta2 / zeta);
+}
+
+int ZipfianKeyGenerator::next() {
+  double u = distribution(rng);
+  double uz = u * zeta;
+
+  if (uz < 1 || positions == 1)
+    return 0;
+  if (uz < 1 + std::pow(0.5, theta))
+    return 1;
+
+  int position = positions * std::pow(eta * u - eta + 1, alpha);
+  return std::min(position, positions - 1);
+}
+
+SequentialKeyGenerator::SequentialKeyGenerator(int positions, int stride,
+                                               int start)
+    : positions(positions), stride(stride), cursor(start % positions) {}
+
+int SequentialKeyGenerator::next() {
+  int position = cursor;
+  cursor = (cursor + stride) % positions;
+  return position;
+}
+
+std::unique_ptr<KeyGenerator> make_key_generator(int distribution,
+                                                 int positions, uint32_t seed,
+                                                 int stride, int start) {
+  switch (distribution) {
+  case KEY_DIST_UNIFORM:
+    return std::make_unique<UniformKeyGenerator>(positions, seed);
+  case KEY_DIST_ZIPFIAN:
+    return std::make_unique<ZipfianKeyGenerator>(positions, ZIPFIAN_THETA,
+                                                 seed);
+  case KEY_DIST_SEQUENTIAL:
+    return std::make_unique<SequentialKeyGenerator>(positions, stride, start);
+  default:
+    throw std::runtime_error(
+        std::format("Unknown key distribution {0}", distribution));
+  }
+}
+
+/**
+ * Every power of two from `2^LATENCY_SUB_BUCKET_BITS` up to `2^63` gets its own
+ * group of buckets, on top of the group of exact values below them
+ */
+LatencyHistogram::LatencyHistogram()
+    : counts((64 - LATENCY_SUB_BUCKET_BITS + 1) << LATENCY_SUB_BUCKET_BITS) {}
+
+void LatencyHistogram::record(uint64_t nanos) {
+  constexpr uint64_t sub_buckets = 1ULL << LATENCY_SUB_BUCKET_BITS;
+  if (nanos < sub_buckets) {
+    counts[nanos]++;
+    return;
+  }
+
+  int exponent = std::bit_width(nanos) - 1;
+  int group = exponent - LATENCY_SUB_BUCKET_BITS + 1;
+  uint64_t sub_bucket = (nanos >> (group - 1)) - sub_buckets;
+  counts[group * sub_buckets + sub_bucket]++;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+  for (size_t i = 0; i < counts.size(); i++)
+    counts[i] += other.counts[i];
+}
+
+uint64_t LatencyHistogram::count() const {
+  return std::accumulate(counts.begin(), counts.end(), 0ULL);
+}
+
+uint64_t LatencyHistogram::percentile(double quantile) const {
+  constexpr uint64_t sub_buckets = 1ULL << LATENCY_SUB_BUCKET_BITS;
+  uint64_t total = count();
+  if (total == 0)
+    return 0;
+
+  uint64_t rank = std::max<uint64_t>(std::ceil(quantile * total), 1);
+  uint64_t seen = 0;
+  size_t index = 0;
+  for (; index < counts.size(); index++) {
+    seen += counts[index];
+    if (seen >= rank)
+      break;
+  }
+
+  uint64_t group = index / sub_buckets;
+  uint64_t sub_bucket = index % sub_buckets;
+  return group == 0 ? sub_bucket : (sub_buckets + sub_bucket) << (group - 1);
+}
+
+std::vector<uint64_t> &LatencyHistogram::buckets() { return counts; }
@@ -0,0 +1,125 @@
+#ifndef __WORKLOAD_H__
+#define __WORKLOAD_H__
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * Picks the first block of every operation of a synthetic workload, out of
+ * `positions` starting positions (0 through `positions - 1`); each generator
+ * belongs to a single thread
+ */
+class KeyGenerator {
+public:
+  /**
+   * Resolves the first block of the next operation
+   */
+  virtual int next() = 0;
+  virtual ~KeyGenerator() = default;
+};
+
+/**
+ * Every position is equally likely
+ */
+class UniformKeyGenerator : public KeyGenerator {
+public:
+  UniformKeyGenerator(int positions, uint32_t seed);
+  int next() override;
+
+private:
+  std::mt19937 rng;
+  std::uniform_int_distribution<int> distribution;
+};
+
+/**
+ * Zipfian distribution with skew `theta`: position 0 is the most likely, and
+ * the likelihood of position `i` falls as `1 / (i + 1)^theta`. Positions are
+ * drawn in constant time (as in YCSB, after Gray et al., "Quickly Generating
+ * Billion-Record Synthetic Databases"), once the zeta constant of all of them
+ * is summed up at construction
+ */
+class ZipfianKeyGenerator : public KeyGenerator {
+public:
+  ZipfianKeyGenerator(int positions, double theta, uint32_t seed);
+  int next() override;
+
+private:
+  std::mt19937 rng;
+  std::uniform_real_distribution<double> distribution;
+  int positions;
+  double theta;
+  double zeta;
+  double alpha;
+  double eta;
+};
+
+/**
+ * Positions are visited in order from `start`, `stride` apart, wrapping
+ * around past the last one
+ */
+class SequentialKeyGenerator : public KeyGenerator {
+public:
+  SequentialKeyGenerator(int positions, int stride, int start);
+  int next() override;
+
+private:
+  int positions;
+  int stride;
+  int cursor;
+};
+
+/**
+ * Builds the generator identified by `distribution` (one of the `KEY_DIST_*`
+ * constants) over `positions` positions; `seed` seeds random generators, while
+ * sequential ones start at `start` (modulo `positions`) and advance `stride`
+ * positions at a time
+ */
+std::unique_ptr<KeyGenerator> make_key_generator(int distribution,
+                                                 int positions, uint32_t seed,
+                                                 int stride, int start);
+
+/**
+ * Log-linear histogram of latencies, in nanoseconds: values below
+ * `2^LATENCY_SUB_BUCKET_BITS` get a bucket each, and every larger power of two
+ * is split into `2^LATENCY_SUB_BUCKET_BITS` buckets, so that percentiles are
+ * resolved within a relative error of `2^-LATENCY_SUB_BUCKET_BITS`. Counts are
+ * kept in a flat array, so that histograms of several processes can be summed
+ * with a single reduction
+ */
+class LatencyHistogram {
+public:
+  LatencyHistogram();
+
+  /**
+   * Count a single latency of `nanos` nanoseconds
+   */
+  void record(uint64_t nanos);
+
+  /**
+   * Add every count of `other` to this histogram
+   */
+  void merge(const LatencyHistogram &other);
+
+  /**
+   * Number of latencies counted
+   */
+  uint64_t count() const;
+
+  /**
+   * Latency (in nanoseconds, rounded down to the bounds of its bucket) at
+   * `quantile` (within 0 and 1) of those counted; 0 if none were
+   */
+  uint64_t percentile(double quantile) const;
+
+  /**
+   * Counts of every bucket, in order
+   */
+  std::vector<uint64_t> &buckets();
+
+private:
+  std::vector<uint64_t> counts;
+};
+
+#endif